@@ -0,0 +1,209 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <tuple>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Times one component update pass over a crowd of enemy shaped entities, once through the Archetype style fold
+//and once through the per-entity vector of unique_ptr components that entities used before. The components
+//are cut down stand-ins for Enemy's ChaseMovement, Animation, Buffable and HealthBar, without the drawing
+
+struct Body {
+    SDL_Rect rect = {0, 0, 80, 80};
+    SDL_Rect position = {0, 0, 80, 80};
+    SDL_FPoint velocity = {0, 0};
+    int clipX = 0;
+    int frames = 4;
+    int health = 100;
+    int startingHealth = 100;
+    int frameStep = 1;
+    bool visible = true;
+    Uint32 checksum = 0;
+};
+
+class BenchComponent {
+    public:
+        virtual ~BenchComponent() {};
+        virtual void update(Body* b) = 0;
+        static constexpr bool visual = false;
+        virtual bool isVisual() { return false; }
+};
+
+class Movement : public BenchComponent {
+    private:
+        float _remainderX = 0;
+        float _remainderY = 0;
+    public:
+        void update(Body* b) {
+            _remainderX += b->velocity.x * b->frameStep;
+            _remainderY += b->velocity.y * b->frameStep;
+            int stepX = (int)_remainderX;
+            int stepY = (int)_remainderY;
+            _remainderX -= stepX;
+            _remainderY -= stepY;
+            b->position.x += stepX;
+            b->position.y += stepY;
+        }
+};
+
+class Animation : public BenchComponent {
+    private:
+        int _frameTime = 0;
+    public:
+        static constexpr bool visual = true;
+        bool isVisual() { return true; }
+
+        void update(Body* b) {
+            if (++_frameTime < 6) {
+                return;
+            }
+            _frameTime = 0;
+            b->rect.x += b->rect.w;
+            if (b->rect.x >= b->clipX + b->frames * b->rect.w) {
+                b->rect.x = b->clipX;
+            }
+        }
+};
+
+class Buffable : public BenchComponent {
+    private:
+        int _damageBoostTimer = 0;
+        int _armorBoostTimer = 0;
+        int _speedBoostTimer = 0;
+    public:
+        void update(Body* b) {
+            _damageBoostTimer = max(0, _damageBoostTimer - b->frameStep);
+            _armorBoostTimer = max(0, _armorBoostTimer - b->frameStep);
+            _speedBoostTimer = max(0, _speedBoostTimer - b->frameStep);
+        }
+};
+
+class HealthBar : public BenchComponent {
+    private:
+        int _shownHealth = -1;
+        int _shownStartingHealth = -1;
+        int _frame = 0;
+    public:
+        static constexpr bool visual = true;
+        bool isVisual() { return true; }
+
+        void update(Body* b) {
+            if (b->health != _shownHealth || b->startingHealth != _shownStartingHealth) {
+                _frame = min(5, max(0, b->health * 6 / max(1, b->startingHealth)));
+                _shownHealth = b->health;
+                _shownStartingHealth = b->startingHealth;
+            }
+            if (_shownHealth < _shownStartingHealth) {
+                b->checksum += _frame;
+            }
+        }
+};
+
+class BenchEntity : public Body {
+    public:
+        virtual ~BenchEntity() {};
+        virtual void update() = 0;
+};
+
+//Same fold as Archetype::updateComponents
+template<typename... Components>
+class FoldEntity : public BenchEntity {
+    private:
+        tuple<Components...> _components;
+
+        template<typename C>
+        void updateComponent(C& component) {
+            if constexpr (C::visual) {
+                if (!visible) {
+                    return;
+                }
+            }
+            component.C::update(this);
+        }
+    public:
+        void update() { (updateComponent(get<Components>(_components)), ...); }
+};
+
+//Same loop as the old Entity::updateComponents
+class VirtualEntity : public BenchEntity {
+    private:
+        vector<unique_ptr<BenchComponent>> _components;
+    public:
+        VirtualEntity() {
+            _components.push_back(make_unique<Movement>());
+            _components.push_back(make_unique<Animation>());
+            _components.push_back(make_unique<Buffable>());
+            _components.push_back(make_unique<HealthBar>());
+        }
+
+        void update() {
+            for (unique_ptr<BenchComponent>& component : _components) {
+                if (!visible && component->isVisual()) {
+                    continue;
+                }
+                component->update(this);
+            }
+        }
+};
+
+template<typename T>
+static double runCase(int entityCount, int frames, Uint32& checksum) {
+    mt19937 random(1234);
+    uniform_real_distribution<float> speeds(-2, 2);
+    uniform_int_distribution<int> percent(0, 99);
+
+    //Entities are allocated one at a time, as the pools do
+    vector<BenchEntity*> entities;
+    for (int i = 0; i < entityCount; i++) {
+        BenchEntity* entity = new T();
+        entity->velocity = {speeds(random), speeds(random)};
+        entity->visible = percent(random) < 30;
+        entities.push_back(entity);
+    }
+
+    double total = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        //Some enemies take a hit each frame, outside the timed part
+        for (int i = frame % 7; i < entityCount; i += 7) {
+            entities[i]->health = max(0, entities[i]->health - 1);
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (BenchEntity* entity : entities) {
+            entity->update();
+        }
+        total += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    for (BenchEntity* entity : entities) {
+        checksum += entity->checksum + entity->position.x + entity->rect.x;
+        delete entity;
+    }
+    return total / frames;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+
+    for (int entities : {256, 20000}) {
+        Uint32 foldChecksum = 0;
+        Uint32 virtualChecksum = 0;
+        double fold = runCase<FoldEntity<Movement, Animation, Buffable, HealthBar>>(entities, frames, foldChecksum);
+        double virtualCalls = runCase<VirtualEntity>(entities, frames, virtualChecksum);
+
+        cout << entities << " entities: fold " << fold * 1000000 / entities << " ns, virtual "
+             << virtualCalls * 1000000 / entities << " ns per entity update, fold takes "
+             << fold / virtualCalls * 100 << "% of the virtual time";
+        if (foldChecksum != virtualChecksum) {
+            cout << " (results differ)";
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include <sdl/SDL.h>
+
+#include <headers/collision.h>
+
+using namespace std;
+
+//Runs both broadphases over the colliders a crowd of chasing enemies gives, gathered in the same order as
+//EntityManager::updateCollisions, and reports the time per frame. Projectiles come and go between the player
+//and the enemies, so collider indices shift every frame the way they do in the game
+
+struct Body {
+    float x;
+    float y;
+    float speed;
+};
+
+struct Projectile {
+    float x;
+    float y;
+    float dx;
+    float dy;
+};
+
+static const int worldSize = 8000;
+
+//Same placement as Entity::setRandomLocation, without the walls
+static Body randomBody(mt19937& random, SDL_Rect area, int size, float speed) {
+    int left = max(0, area.x);
+    int top = max(0, area.y);
+    int right = min(worldSize, area.x + area.w) - size;
+    int bottom = min(worldSize, area.y + area.h) - size;
+    uniform_int_distribution<int> spreadX(left, max(left, right));
+    uniform_int_distribution<int> spreadY(top, max(top, bottom));
+    return {(float)spreadX(random), (float)spreadY(random), speed};
+}
+
+static void addCollider(vector<Collider>& colliders, Uint32 id, int part, float x, float y, int size, Uint32 layer, Uint32 mask) {
+    Collider collider;
+    collider.id = id;
+    collider.part = part;
+    collider.box = {(int)x, (int)y, size, size};
+    collider.layer = layer;
+    collider.mask = mask;
+    colliders.push_back(collider);
+}
+
+//Drops the pairs the narrowphase would reject, each broadphase is free to hand over different near misses
+static void keepOverlapping(const vector<Collider>& colliders, vector<pair<int, int>>& pairs) {
+    pairs.erase(remove_if(pairs.begin(), pairs.end(), [&](const pair<int, int>& candidate) {
+        return !SDL_HasIntersection(&colliders[candidate.first].box, &colliders[candidate.second].box);
+    }), pairs.end());
+    sort(pairs.begin(), pairs.end());
+}
+
+static void runCase(const char* name, SDL_Rect area, int enemyCount, int frames) {
+    mt19937 random(1234);
+    uniform_real_distribution<float> speeds(1, 2);
+    uniform_real_distribution<float> angles(0, 6.2831853f);
+
+    float playerX = worldSize / 2;
+    float playerY = worldSize / 2;
+    vector<Body> enemies;
+    vector<Body> coins;
+    for (int i = 0; i < enemyCount; i++) {
+        enemies.push_back(randomBody(random, area, 80, speeds(random)));
+    }
+    for (int i = 0; i < enemyCount / 4; i++) {
+        coins.push_back(randomBody(random, area, 40, 0));
+    }
+    vector<Projectile> projectiles;
+
+    GridBroadphase grid;
+    SweepAndPrune sweep;
+    grid.init(worldSize, worldSize, 64);
+
+    vector<Collider> colliders;
+    vector<pair<int, int>> gridPairs;
+    vector<pair<int, int>> sweepPairs;
+    double gridTotal = 0;
+    double sweepTotal = 0;
+    bool matched = true;
+
+    for (int frame = 0; frame < frames; frame++) {
+        //Ids follow creation order: the player, then enemies, then coins
+        colliders.clear();
+        addCollider(colliders, 1, -1, playerX, playerY, 80, PlayerLayer, PowerUpLayer | CoinLayer);
+        for (int i = 0; i < (int)projectiles.size(); i++) {
+            addCollider(colliders, 1, i, projectiles[i].x, projectiles[i].y, 7, ProjectileLayer, EnemyLayer);
+        }
+        for (int i = 0; i < enemyCount; i++) {
+            addCollider(colliders, 2 + i, -1, enemies[i].x, enemies[i].y, 80, EnemyLayer, ProjectileLayer);
+        }
+        for (int i = 0; i < (int)coins.size(); i++) {
+            addCollider(colliders, 2 + enemyCount + i, -1, coins[i].x, coins[i].y, 40, CoinLayer, PlayerLayer);
+        }
+
+        gridPairs.clear();
+        auto start = chrono::steady_clock::now();
+        grid.findPairs(colliders, gridPairs);
+        gridTotal += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        sweepPairs.clear();
+        start = chrono::steady_clock::now();
+        sweep.findPairs(colliders, sweepPairs);
+        sweepTotal += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        //Both have to lead to the same contacts
+        keepOverlapping(colliders, gridPairs);
+        keepOverlapping(colliders, sweepPairs);
+        if (gridPairs != sweepPairs) {
+            matched = false;
+        }
+
+        //Movement is outside the timed part
+        for (Body& enemy : enemies) {
+            float dx = playerX - enemy.x;
+            float dy = playerY - enemy.y;
+            float length = max(1.0f, sqrt(dx * dx + dy * dy));
+            enemy.x += dx / length * enemy.speed;
+            enemy.y += dy / length * enemy.speed;
+        }
+        if (frame % 2 == 0) {
+            float angle = angles(random);
+            projectiles.push_back({playerX + 36, playerY + 36, cos(angle) * 4, sin(angle) * 4});
+        }
+        //Spent projectiles leave the same way MovementBuffer::remove does, the last one fills the gap
+        for (int i = (int)projectiles.size() - 1; i >= 0; i--) {
+            projectiles[i].x += projectiles[i].dx;
+            projectiles[i].y += projectiles[i].dy;
+            if (abs(projectiles[i].x - playerX) > 1000 || abs(projectiles[i].y - playerY) > 1000) {
+                projectiles[i] = projectiles.back();
+                projectiles.pop_back();
+            }
+        }
+    }
+
+    cout << name << ", " << enemyCount << " enemies: grid " << gridTotal / frames << " ms, sweep and prune "
+         << sweepTotal / frames << " ms per frame" << (matched ? "" : ", the pairs differ") << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+
+    for (int enemies : {256, 2000}) {
+        runCase("Spread over the world", {0, 0, worldSize, worldSize}, enemies, frames);
+        runCase("Clustered in three screens around the player", {2800, 2800, 2400, 2400}, enemies, frames);
+    }
+    return 0;
+}
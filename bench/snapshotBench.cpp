@@ -0,0 +1,75 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+#include <headers/snapshot.h>
+#include <headers/entity.h>
+
+using namespace std;
+
+//Captures and restores a world of enemies the way Game::captureSnapshot and EntityManager::loadSnapshot do,
+//and reports the time per frame against the 1 ms target for 10k entities. The enemies are default constructed,
+//their components write the same fields as in the game but nothing is drawn or loaded from disk
+
+int main(int argc, char* argv[]) {
+    int entityCount = argc > 1 ? atoi(argv[1]) : 10000;
+    int frames = argc > 2 ? atoi(argv[2]) : 600;
+
+    mt19937 random(1234);
+    uniform_int_distribution<int> spread(0, 8000);
+    vector<Enemy*> enemies;
+    for (int i = 0; i < entityCount; i++) {
+        Enemy* enemy = new Enemy();
+        enemy->setLocation(spread(random), spread(random));
+        enemies.push_back(enemy);
+    }
+
+    Snapshot snapshot;
+    double saveTotal = 0;
+    double saveWorst = 0;
+    double loadTotal = 0;
+    double loadWorst = 0;
+    bool matched = true;
+
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = chrono::steady_clock::now();
+        snapshot.clear();
+        snapshot.writeHeader();
+        snapshot.write<int>(enemies.size());
+        for (Enemy* enemy : enemies) {
+            enemy->save(snapshot);
+        }
+        double saveTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        snapshot.readHeader();
+        int count = snapshot.read<int>();
+        for (int i = 0; i < count && i < (int)enemies.size(); i++) {
+            enemies[i]->load(snapshot);
+        }
+        double loadTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        //Everything written has to have been read back
+        if (count != entityCount || snapshot.remaining() != 0) {
+            matched = false;
+        }
+
+        saveTotal += saveTime;
+        saveWorst = max(saveWorst, saveTime);
+        loadTotal += loadTime;
+        loadWorst = max(loadWorst, loadTime);
+    }
+
+    cout << entityCount << " entities, " << snapshot.size() << " bytes: capture " << saveTotal / frames << " ms (worst "
+         << saveWorst << " ms), restore " << loadTotal / frames << " ms (worst " << loadWorst << " ms) per frame"
+         << (matched ? "" : ", the restore did not read back what was written") << endl;
+
+    for (Enemy* enemy : enemies) {
+        delete enemy;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+#include <headers/steering.h>
+#include <headers/flowField.h>
+
+using namespace std;
+
+//Steps a crowd of chasing agents the way EntityManager::updateSteering does and reports the time per step.
+//The flow field is left uninitialised, so every agent seeks straight at the target
+
+struct Agent {
+    float x;
+    float y;
+    SDL_FPoint velocity;
+    float speed;
+};
+
+static void runCase(const char* name, int agentCount, SDL_Rect area, int frames) {
+    const int worldSize = 8000;
+    mt19937 random(1234);
+    uniform_real_distribution<float> spreadX(area.x, area.x + area.w);
+    uniform_real_distribution<float> spreadY(area.y, area.y + area.h);
+    uniform_int_distribution<int> speeds(1, 2);
+
+    vector<Agent> agents(agentCount);
+    for (Agent& agent : agents) {
+        agent = {spreadX(random), spreadY(random), {0, 0}, (float)speeds(random)};
+    }
+
+    CrowdSteering steering;
+    FlowField field;
+    steering.init(worldSize, worldSize);
+
+    double total = 0;
+    double worst = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = chrono::steady_clock::now();
+
+        steering.clear();
+        for (const Agent& agent : agents) {
+            steering.addAgent(agent.x, agent.y, agent.velocity, agent.speed);
+        }
+        steering.update(field, worldSize / 2, worldSize / 2);
+        for (int i = 0; i < agentCount; i++) {
+            agents[i].velocity = steering.getVelocity(i);
+        }
+
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        total += elapsed;
+        worst = max(worst, elapsed);
+
+        //Movement is outside the timed part, it belongs to the entities
+        for (Agent& agent : agents) {
+            agent.x = min(max(agent.x + agent.velocity.x, 0.0f), worldSize - 1.0f);
+            agent.y = min(max(agent.y + agent.velocity.y, 0.0f), worldSize - 1.0f);
+        }
+    }
+
+    double average = total / frames;
+    cout << name << ": " << agentCount << " agents, " << average << " ms average, " << worst << " ms worst per step, "
+         << (average < 1000.0 / 60 ? "fits" : "misses") << " a 60 Hz frame" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    int agents = argc > 1 ? atoi(argv[1]) : 20000;
+    int frames = argc > 2 ? atoi(argv[2]) : 600;
+
+#if defined(__SSE__) || defined(_M_X64)
+    cout << "Steering with SSE" << endl;
+#else
+    cout << "Steering with the scalar fallback" << endl;
+#endif
+    runCase("Spread over the world", agents, {0, 0, 8000, 8000}, frames);
+    runCase("Clustered in three screens around the target", agents, {2800, 2800, 2400, 2400}, frames);
+    return 0;
+}
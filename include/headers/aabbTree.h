@@ -0,0 +1,84 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Binary tree of boxes for colliders that rarely move. Leaves keep a box grown by a margin, so small moves
+//only update the leaf and a query or ray skips every branch whose box it misses
+class AabbTree {
+    private:
+        struct Node {
+            SDL_Rect box = {0, 0, 0, 0}; //Grown by the margin for leaves, covers both children otherwise
+            SDL_Rect tight = {0, 0, 0, 0};
+            int parent = -1; //Next free node while the node is unused
+            int left = -1; //-1 for leaves
+            int right = -1;
+            int data = -1;
+        };
+
+        vector<Node> _nodes;
+        vector<int> _stack;
+        int _root = -1;
+        int _free = -1;
+        int _margin = 8;
+        int _leaves = 0;
+
+        int allocate();
+        void release(int index);
+        void insertLeaf(int leaf);
+        void removeLeaf(int leaf);
+        void refit(int index);
+        bool isLeaf(int index) { return _nodes[index].left < 0; }
+
+        static SDL_Rect unite(const SDL_Rect& a, const SDL_Rect& b);
+        static int perimeter(const SDL_Rect& box) { return 2 * (box.w + box.h); }
+        static bool contains(const SDL_Rect& outer, const SDL_Rect& inner);
+        static bool rayHits(const SDL_Rect& box, SDL_FPoint from, SDL_FPoint delta, float maxFraction, float& fraction);
+    public:
+        AabbTree() {};
+        AabbTree(int margin) : _margin(margin) {};
+
+        int insert(SDL_Rect box, int data);
+        void remove(int proxy);
+        bool move(int proxy, SDL_Rect box);
+        void clear();
+
+        int raycast(SDL_FPoint from, SDL_FPoint to, float& fraction);
+
+        int getData(int proxy) { return _nodes[proxy].data; }
+        SDL_Rect getBox(int proxy) { return _nodes[proxy].tight; }
+        int getLeafCount() { return _leaves; }
+
+        //Visits the proxy of every leaf whose own box overlaps the area. Not reentrant, the visitor must not query
+        template<typename Visitor>
+        void query(SDL_Rect area, Visitor visit) {
+            if (_root < 0) {
+                return;
+            }
+            _stack.clear();
+            _stack.push_back(_root);
+            while (!_stack.empty()) {
+                int index = _stack.back();
+                _stack.pop_back();
+                const Node& node = _nodes[index];
+                if (!SDL_HasIntersection(&node.box, &area)) {
+                    continue;
+                }
+                if (isLeaf(index)) {
+                    if (SDL_HasIntersection(&node.tight, &area)) {
+                        visit(index);
+                    }
+                }
+                else {
+                    _stack.push_back(node.left);
+                    _stack.push_back(node.right);
+                }
+            }
+        }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include <sdl/SDL.h>
+
+#include <headers/frameArena.h>
+
+using namespace std;
+
+//Reports asset files that changed on disk, through inotify on Linux and ReadDirectoryChangesW on Windows,
+//and by polling modification times everywhere else
+class AssetWatcher {
+    private:
+        vector<string> _directories;
+        map<string, long long> _modified; //Used by the polling fallback
+
+        //Shared with the watch thread, guarded by _mutex
+        SDL_Thread* _thread = nullptr;
+        SDL_mutex* _mutex = nullptr;
+        bool _running = false;
+        vector<string> _changed;
+
+        int _inotify = -1;
+        map<int, string> _watches; //inotify watch, or index into _directoryHandles on Windows, to its directory
+        vector<void*> _directoryHandles; //Windows directory HANDLEs, each watched with its sub directories
+
+        static int watchThread(void* data);
+        void addWatches(const string& directory);
+        long long modifiedTime(const string& filepath);
+    public:
+        AssetWatcher() {};
+        AssetWatcher(const AssetWatcher&) = delete;
+        ~AssetWatcher();
+
+        void start(const vector<string>& directories);
+        void poll(const FrameVector<const string*>& filepaths);
+        vector<string> takeChanged();
+        bool isNative() { return _thread != nullptr; }
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+
+#include <sdl/SDL.h>
+#include <sdl/SDL_image.h>
+#include <sdl/SDL_mixer.h>
+#include <sdl/SDL_ttf.h>
+
+#include <headers/assetWatcher.h>
+#include <headers/resources.h>
+
+using namespace std;
+
+//Handles stay at the same address for the whole run, the texture or chunk inside is filled in once loaded
+struct TextureAsset {
+    SDL_Texture* texture = nullptr; //A transparent placeholder until the upload completes
+    TextureHandle loaded;
+    int width = 0;
+    int height = 0;
+    int version = 0; //Goes up with every upload, so anything drawn from the pixels can tell it is stale
+    bool ready = false;
+};
+
+struct SoundAsset {
+    ChunkHandle chunk;
+    int volume = MIX_MAX_VOLUME;
+    bool ready = false;
+};
+
+struct FontAsset {
+    FontHandle font;
+    vector<char> data; //The file a reloaded font was opened from, SDL_ttf reads from it for as long as the font is open
+    string filepath;
+    int size = 0;
+};
+
+//Decodes images and sounds and reads reloaded fonts on loader threads, textures and fonts are then created
+//on the game thread within a time budget
+class AssetManager {
+    private:
+        struct LoadJob {
+            string filepath;
+            TextureAsset* texture = nullptr;
+            SoundAsset* sound = nullptr;
+            FontAsset* font = nullptr;
+            SurfaceHandle surface;
+            ChunkHandle chunk;
+            vector<char> data;
+        };
+
+        SDL_Renderer* _renderer = nullptr;
+        TextureHandle _placeholder;
+
+        map<string, unique_ptr<TextureAsset>> _textures;
+        map<string, unique_ptr<SoundAsset>> _sounds;
+        map<string, unique_ptr<FontAsset>> _fonts;
+
+        AssetWatcher _watcher;
+        int _pollTimer = 0;
+        int _pollInterval = 30; //Frames between modification time checks when there is no native watcher
+
+        //Shared with the loader threads, guarded by _mutex
+        vector<SDL_Thread*> _workers;
+        SDL_mutex* _mutex = nullptr;
+        SDL_cond* _condition = nullptr;
+        deque<LoadJob> _pending;
+        deque<LoadJob> _decoded;
+        int _busy = 0;
+        bool _running = false;
+
+        static int workerThread(void* data);
+        static void decode(LoadJob& job);
+        void queue(LoadJob&& job);
+        void finish(LoadJob& job);
+        void reloadChanged();
+        void reload(const string& filepath);
+
+        AssetManager() {};
+    public:
+        AssetManager(const AssetManager&) = delete;
+        ~AssetManager();
+
+        static AssetManager& get() {
+            static AssetManager instance;
+            return instance;
+        }
+
+        void init(SDL_Renderer* renderer, int workerCount = 2);
+        void shutdown();
+
+        TextureAsset* getTexture(const string& filepath);
+        TextureAsset* getTextureNow(const string& filepath);
+        SoundAsset* getSound(const string& filepath, int volume = MIX_MAX_VOLUME);
+        FontAsset* getFont(const string& filepath, int size);
+
+        void uploadPending(double budgetMs);
+        void waitUntilLoaded();
+        void watch(const vector<string>& directories) { _watcher.start(directories); }
+};
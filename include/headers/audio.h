@@ -0,0 +1,60 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+#include <sdl/SDL_mixer.h>
+
+#include <headers/assets.h>
+#include <headers/resources.h>
+
+using namespace std;
+
+//Collects the frame's sound requests and starts them together, with a voice cap per sound and overall.
+//When every channel is busy a request can take over the oldest voice of a lower priority
+class AudioDispatcher {
+    private:
+        struct SoundSettings {
+            SoundAsset* sound;
+            int priority;
+            int maxVoices;
+        };
+
+        struct Voice {
+            SoundAsset* sound = nullptr;
+            int priority = 0;
+            Uint32 started = 0;
+        };
+
+        vector<SoundSettings> _settings;
+        vector<Voice> _voices; //One per mixer channel
+        vector<SoundSettings> _requests;
+        int _defaultMaxVoices = 4;
+
+        MusicHandle _music;
+        bool _musicPlaying = false;
+
+        SoundSettings settingsFor(SoundAsset* sound);
+        int findChannel(const SoundSettings& request);
+
+        AudioDispatcher() {};
+    public:
+        AudioDispatcher(const AudioDispatcher&) = delete;
+
+        static AudioDispatcher& get() {
+            static AudioDispatcher instance;
+            return instance;
+        }
+
+        void init(int channels);
+        void configure(SoundAsset* sound, int priority, int maxVoices);
+        void play(SoundAsset* sound);
+        void flush();
+        void clear();
+
+        bool playMusic(const string& filepath, int volume);
+        void toggleMusic();
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <iostream>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Window sized view into the world that follows the player
+class Camera {
+    private:
+        SDL_Rect _view = {0, 0, 0, 0};
+        int _worldWidth = 0;
+        int _worldHeight = 0;
+    public:
+        Camera() {};
+
+        void init(int screenWidth, int screenHeight, int worldWidth, int worldHeight);
+        void follow(SDL_Rect target);
+
+        SDL_Rect getView() { return _view; }
+        SDL_Rect toScreen(SDL_Rect world) { return {world.x - _view.x, world.y - _view.y, world.w, world.h}; }
+        SDL_Point toWorld(int screenX, int screenY) { return {screenX + _view.x, screenY + _view.y}; }
+        bool canSee(SDL_Rect world) { return SDL_HasIntersection(&world, &_view); }
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <tuple>
+
+#include <sdl/SDL.h>
+
+#include <headers/spatialGrid.h>
+
+using namespace std;
+
+class Entity;
+
+enum CollisionLayer {
+    PlayerLayer = 1 << 0,
+    EnemyLayer = 1 << 1,
+    ProjectileLayer = 1 << 2,
+    PowerUpLayer = 1 << 3,
+    CoinLayer = 1 << 4,
+    ObstacleLayer = 1 << 5
+};
+
+struct Collider {
+    Entity* entity = nullptr;
+    Uint32 id = 0; //The entity's id, so ordering never has to reach into the entity
+    int part = -1; //Which of the entity's extra colliders this is, like a weapon's projectile, -1 for the entity itself
+    SDL_Rect box = {0, 0, 0, 0};
+    Uint32 layer = 0; //The one layer this collider is on
+    Uint32 mask = 0; //Every layer it wants contacts with
+};
+
+//Two overlapping colliders, side a being the one with the lower entity id (then part)
+struct Contact {
+    Uint32 idA = 0;
+    Uint32 idB = 0;
+    int partA = -1;
+    int partB = -1;
+    int a = 0; //Collider indices
+    int b = 0;
+};
+
+//A pair is only worth testing when each side is on a layer the other one asks for
+inline bool layersInteract(const Collider& a, const Collider& b) {
+    return (a.layer & b.mask) != 0 && (b.layer & a.mask) != 0;
+}
+
+//Finds the candidate pairs for a frame's colliders, each pair once with the lower index first
+class Broadphase {
+    public:
+        virtual ~Broadphase() {};
+        virtual void findPairs(const vector<Collider>& colliders, vector<pair<int, int>>& pairs) = 0;
+        virtual const char* getName() = 0;
+};
+
+//Bins colliders by centre on a uniform grid, best when they are spread across the world
+class GridBroadphase : public Broadphase {
+    private:
+        SpatialGrid _grid;
+        vector<float> _centreX;
+        vector<float> _centreY;
+    public:
+        GridBroadphase() {};
+
+        void init(int worldWidth, int worldHeight, int cellSize) { _grid.init(worldWidth, worldHeight, cellSize); }
+        void findPairs(const vector<Collider>& colliders, vector<pair<int, int>>& pairs);
+        const char* getName() { return "grid"; }
+};
+
+//Keeps the colliders sorted along x between frames. Little moves from one frame to the next,
+//so the insertion sort is close to linear, and clumps that overload a grid cell cost nothing extra.
+//The order is kept by entity id and part, since a collider's index shifts whenever something before it comes or goes
+class SweepAndPrune : public Broadphase {
+    private:
+        vector<Uint64> _lastOrder; //Handles by left edge from the last frame
+        vector<int> _order; //Collider indices by left edge
+        vector<int> _active;
+
+        //Open addressing table from handle to this frame's collider index, sized to the largest frame seen
+        vector<Uint64> _slotHandles;
+        vector<int> _slotIndices;
+        vector<Uint8> _placed;
+
+        static Uint64 handle(const Collider& collider) { return (Uint64)collider.id << 32 | (Uint32)(collider.part + 1); }
+        void buildSlots(const vector<Collider>& colliders);
+        int findSlot(Uint64 key);
+    public:
+        SweepAndPrune() {};
+
+        void findPairs(const vector<Collider>& colliders, vector<pair<int, int>>& pairs);
+        const char* getName() { return "sweep and prune"; }
+};
+
+//Gathers every collider for the frame, finds the overlapping pairs and tells both entities about each contact
+class CollisionWorld {
+    private:
+        struct Worker {
+            CollisionWorld* world = nullptr;
+            int slice = 0;
+        };
+
+        vector<Collider> _colliders;
+        vector<pair<int, int>> _pairs;
+        vector<Contact> _contacts;
+
+        GridBroadphase _grid;
+        SweepAndPrune _sweep;
+        Broadphase* _broadphase = &_grid;
+
+        //One contact buffer per slice of the pair list, slice 0 is tested on the game thread
+        vector<vector<Contact>> _buffers;
+        int _parallelThreshold = 256; //Fewer pairs than this aren't worth waking the workers for
+
+        //Shared with the worker threads, guarded by _mutex
+        vector<SDL_Thread*> _threads;
+        vector<Worker> _workers;
+        SDL_mutex* _mutex = nullptr;
+        SDL_cond* _start = nullptr;
+        SDL_cond* _done = nullptr;
+        int _generation = 0;
+        int _finished = 0;
+        bool _running = false;
+
+        static int workerThread(void* data);
+        void testPairs(int slice, int slices, vector<Contact>& contacts);
+        void narrowphase();
+        void resolve();
+    public:
+        CollisionWorld() {};
+        CollisionWorld(const CollisionWorld&) = delete;
+        ~CollisionWorld();
+
+        void init(int worldWidth, int worldHeight, int cellSize, int workerCount = 0);
+        void shutdown();
+        void clear();
+        void add(const Collider& collider);
+        void update();
+        void toggleBroadphase();
+
+        Broadphase& getBroadphase() { return *_broadphase; }
+
+        int getColliderCount() { return _colliders.size(); }
+        int getPairCount() { return _pairs.size(); }
+        int getContactCount() { return _contacts.size(); }
+};
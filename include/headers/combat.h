@@ -0,0 +1,50 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+#include <headers/eventBus.h>
+
+using namespace std;
+
+class Entity;
+
+//One projectile or attack landing, queued straight to the resolver rather than through the bus
+struct Hit {
+    Entity* source = nullptr;
+    Entity* target = nullptr;
+    int amount = 0; //Damage before the target's armor
+    SDL_Point position = {0, 0}; //Where it landed, passed on with the damage event
+};
+
+//Applies a frame's hits in one pass. Hits are grouped per target, the targets' health and armor are copied into
+//packed arrays, mitigation runs over the arrays four targets at a time, and the results are written back with a
+//damage event for each hit and a kill event for each death. Runs before the frame's dispatch, so a kill never
+//waits a frame with the dead entity still in play
+class CombatResolver {
+    private:
+        vector<Hit> _hits;
+        vector<int> _landed; //Index into the packed arrays for each hit, -1 for hits on targets already dead
+        vector<Entity*> _targets;
+
+        //Padded to a multiple of four so the mitigation pass never needs a scalar tail
+        vector<int> _health;
+        vector<int> _armor;
+        vector<int> _incoming;
+
+        int _armorScale = 0; //Armor equal to this halves the damage taken, 0 leaves damage unmitigated as before armor counted
+
+        void applyDamage(int targets);
+    public:
+        CombatResolver() {};
+
+        void addHit(const Hit& hit) { _hits.push_back(hit); }
+        void resolve();
+        void clear();
+
+        void setArmorScale(int scale) { _armorScale = max(0, scale); }
+        int mitigate(int damage, int armor) { return _armorScale == 0 ? damage : damage * _armorScale / (_armorScale + max(0, armor)); }
+};
@@ -10,6 +10,13 @@
 #include <headers/command.h>
 #include <headers/entityManager.h>
 #include <headers/utility.h>
+#include <headers/snapshot.h>
+#include <headers/spriteSheet.h>
+#include <headers/assets.h>
+#include <headers/eventBus.h>
+#include <headers/movement.h>
+#include <headers/fixedPoint.h>
+#include <headers/collision.h>
 
 #include <sdl/SDL.h>
 #include <sdl/SDL_image.h>
@@ -21,7 +28,6 @@ using namespace std;
 class Entity;
 class Player;
 class PowerUp;
-class Projectile;
 
 class Component {
     protected:
@@ -30,6 +36,12 @@ class Component {
         Component() {};
         virtual ~Component() {};
         virtual void update(Entity* e) = 0;
+        static constexpr bool visual = false; //Visual components are skipped while the entity is off screen
+        virtual void save(Snapshot& snapshot) {};
+        virtual bool load(Snapshot& snapshot) { return true; }; //False when the snapshot holds something this cannot be
+        virtual void reset(Entity* e) {};
+        virtual void addColliders(Entity* e, CollisionWorld& world) {};
+        virtual void collide(Entity* e, const Collider& self, const Collider& other) {};
 };
 
 class PlayerControlledMovement : public Component {
@@ -54,6 +66,27 @@ class RandomMovement : public Component {
         ~RandomMovement() {};
 
         void update(Entity* e);
+        void reset(Entity* e);
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
+};
+
+class ChaseMovement : public Component {
+    private:
+        RandomMovement _wander; //Used until the first flow field is ready
+        Fixed _remainderX = 0; //Sub pixel movement carried over to the next frame
+        Fixed _remainderY = 0;
+
+        void faceDirection(Entity* e, int dx, int dy);
+    public:
+        ChaseMovement() {};
+        ChaseMovement(SDL_Renderer* renderer) { _renderer = renderer; }
+        ~ChaseMovement() {};
+
+        void update(Entity* e);
+        void reset(Entity* e);
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
 };
 
 class RangedWeapon : public Component {
@@ -64,13 +97,13 @@ class RangedWeapon : public Component {
         int delayThreshold = 40;
         string _type;
 
-        vector<Projectile*> _projectiles;
-        SDL_Texture* _texture;
-        Mix_Chunk* _shootSound;
+        int _projectileSpeed = 4;
+        MovementBuffer _projectiles = MovementBuffer(7, 7);
+        SpriteClip _projectileClip;
+        vector<int> _hits; //Projectiles that struck an enemy, removed at the start of the next update
 
         void shoot(Entity* entity);
         void updateProjectile(Entity* entity);
-        void destroyProjectile(Projectile* projectile);
     public:
         RangedWeapon() {};
         RangedWeapon(SDL_Renderer* renderer, string type = "gun");
@@ -78,6 +111,11 @@ class RangedWeapon : public Component {
 
         void update(Entity* entity);
         void handleInput();
+        void addColliders(Entity* entity, CollisionWorld& world);
+        void collide(Entity* entity, const Collider& self, const Collider& other);
+        void reset(Entity* entity);
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
 };
 
 class Animation : public Component {
@@ -89,9 +127,9 @@ class Animation : public Component {
         
         vector<SDL_KeyCode> movementKeys = {SDLK_w, SDLK_a, SDLK_s, SDLK_d};
 
-        map<string, SDL_Texture*> _texture1; //Base
-        map<string, SDL_Texture*> _texture2; //Moving (If Exists)
-        map<string, SDL_Texture*> _texture3; //Action (If Exists)
+        map<string, SpriteClip> _clip1; //Base
+        map<string, SpriteClip> _clip2; //Moving
+        map<string, SpriteClip> _clip3; //Action
 
         bool movementKeysNotActivated(bool keysPressed[]);
         bool onlyMovementActivated(SDL_Keycode code, bool keysPressed[]);
@@ -99,10 +137,14 @@ class Animation : public Component {
         void handleEnemyAnimation(Entity* entity);
     public:
         Animation() {};
-        Animation(SDL_Renderer* renderer, int fps, int animationPerSecond, int type, vector<SDL_Texture*> texture1, vector<SDL_Texture*> texture2 = {}, vector<SDL_Texture*> texture3 = {});
+        Animation(SDL_Renderer* renderer, int fps, int animationPerSecond, int type, SpriteSheet* sheet = nullptr);
         ~Animation() {};
 
         void update(Entity* e);
+        static constexpr bool visual = true;
+        void reset(Entity* e);
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
 };
 
 class Buffable : public Component {
@@ -119,47 +161,52 @@ class Buffable : public Component {
         pair<int, int> _armor;
         pair<int, int> _speed;
 
-        SDL_Texture* _damageIndicator = nullptr;
-        SDL_Texture* _armorIndicator = nullptr;
-        SDL_Texture* _speedIndicator = nullptr;
-
-        SDL_Rect _damageIPosition;
-        SDL_Rect _armorIPosition;
-        SDL_Rect _speedIPosition;
+        TextureAsset* _damageIndicator = nullptr;
+        TextureAsset* _armorIndicator = nullptr;
+        TextureAsset* _speedIndicator = nullptr;
 
-        Mix_Chunk* _damageBoostSound;
-        Mix_Chunk* _armorBoostSound;
-        Mix_Chunk* _speedBoostSound;
-        Mix_Chunk* _coinCollectedSound;
+        //Relative to the entity, only the entity's position is added when drawing
+        SDL_Rect _damageOffset = {16, 0, 15, 15};
+        SDL_Rect _armorOffset = {31, 0, 15, 15};
+        SDL_Rect _speedOffset = {46, 0, 15, 15};
 
         void handleBoosts(Entity* e);
         void drawIndicators(Entity* e);
+        void drawIndicator(Entity* e, TextureAsset* indicator, const SDL_Rect& offset);
     public:
         Buffable() {};
         Buffable(SDL_Renderer* renderer, pair<int, int> damage, pair<int, int> armor, pair<int, int> speed);
         ~Buffable() {};
 
         void update(Entity* e);
-        
+        void collide(Entity* e, const Collider& self, const Collider& other);
+        void reset(Entity* e);
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
 };
 
 class CoinCollector : public Component {
-    private:
-        Mix_Chunk* _coinCollectedSound;                
     public:
         CoinCollector() {};
         CoinCollector(SDL_Renderer* renderer);
         ~CoinCollector() {};
 
         void update(Entity* e);
+        void collide(Entity* e, const Collider& self, const Collider& other);
 };
 
 class HealthBar : public Component {
     private:
         SDL_Rect _healthBarPosition;
-        vector<SDL_Texture*> _textures;
-        SDL_Texture* _currentTexture;
+        SDL_Point _offset = {23, 0};
+        vector<TextureAsset*> _textures;
+        TextureAsset* _currentTexture;
+
+        //Health the current frame was picked for, -1 until the first update
+        int _shownHealth = -1;
+        int _shownStartingHealth = -1;
 
+        void selectTexture(Entity* e);
         void drawBar(Entity* e);
     public:
         HealthBar() {};
@@ -167,4 +214,6 @@ class HealthBar : public Component {
         ~HealthBar() {};
 
         void update(Entity* e);
+        void reset(Entity* e);
+        static constexpr bool visual = true;
 };
\ No newline at end of file
@@ -7,10 +7,15 @@
 #include <algorithm>
 #include <memory>
 #include <cmath>
+#include <tuple>
 
 #include <headers/component.h>
 #include <headers/entityManager.h>
 #include <headers/utility.h>
+#include <headers/snapshot.h>
+#include <headers/spriteSheet.h>
+#include <headers/resources.h>
+#include <headers/collision.h>
 
 #include <sdl/SDL.h>
 #include <sdl/SDL_image.h>
@@ -24,32 +29,47 @@ class Entity {
         string _currentDirection = "down";
         SDL_Rect _rect;
         SDL_Rect _position;
-        SDL_Texture* _currentTexture;
+        TextureAsset* _currentTexture = nullptr;
+        SpriteClip _clip; //Frames the animation is currently stepping through
         SDL_Renderer* _renderer;
         SDL_RendererFlip _horizontalFlip = SDL_FLIP_HORIZONTAL;
         SDL_RendererFlip _verticalFlip = SDL_FLIP_VERTICAL;
 
-        int _textureWidth;
-        int _textureHeight;
         int _frameWidth;
         int _frameHeight;
-        int _screenWidth;
-        int _screenHeight;
+        int _worldWidth;
+        int _worldHeight;
         int _speed;
         int _damage;
         int _armor;
         int _fps;
 
-        vector<unique_ptr<Component>> _components;
-        void addComponent(unique_ptr<Component> component);
-        void updateComponents(SDL_Renderer* renderer);
+        SDL_FPoint _velocity = {0, 0}; //Set by crowd steering for enemies that chase the player
+
+        int _frameStep = 1; //Frames covered by this tick, timers and movement scale by it
+        int _skippedFrames = 0;
+        bool _visible = true;
+        bool _removed = false; //Queued for deletion at the next sync, skipped by forEach until then
+
+        static Uint32 _nextId;
+        Uint32 _id; //Creation order, gives collisions and other per frame work a replayable order
+
+        Uint32 _layer = 0;
+        Uint32 _mask = 0;
+
+        virtual void updateComponents() {};
+        virtual void saveComponents(Snapshot& snapshot) {};
+        virtual bool loadComponents(Snapshot& snapshot) { return true; };
+        virtual void resetComponents() {};
 
         void draw(SDL_Renderer* renderer);
+        void step(int dx, int dy);
         void handleEvents();
         void powerUpBoost(PowerUp* powerUp);
 
         friend class PlayerControlledMovement;
         friend class RandomMovement;
+        friend class ChaseMovement;
         friend class Animation;
         friend class Buffable;
         friend class RangedWeapon;
@@ -65,48 +85,109 @@ class Entity {
         bool keys[323] = {false};
         SDL_Keycode lastKeyPressed;
         SDL_Keycode lastKeyReleased;
+
+        Entity() : _id(++_nextId) { ResourceTracker::add(EntityResource, 1); }
+        virtual ~Entity() { ResourceTracker::add(EntityResource, -1); }
         
         bool collision(SDL_Rect otherRect);
+        SDL_Rect getPosition() { return _position; }
+        SDL_FPoint getVelocity() { return _velocity; }
+        void setVelocity(SDL_FPoint velocity) { _velocity = velocity; }
+        int getSpeed() { return _speed; }
+        int getArmor() { return _armor; }
+
+        void skipUpdate() { _skippedFrames++; }
+        void scheduleUpdate() { _frameStep = _skippedFrames + 1; _skippedFrames = 0; }
+        void setVisible(bool visible) { _visible = visible; }
+        bool isVisible() { return _visible; }
+        void markRemoved() { _removed = true; }
+        bool isRemoved() { return _removed; }
+        Uint32 getId() { return _id; }
+        static Uint32 getNextId() { return _nextId; }
+        static void setNextId(Uint32 nextId) { _nextId = nextId; }
+        Uint32 getLayer() { return _layer; }
+        Uint32 getMask() { return _mask; }
+
+        virtual void addColliders(CollisionWorld& world);
+        virtual void collide(const Collider& self, const Collider& other) {};
         
         void moveUp();
         void moveDown();
         void moveLeft();
         void moveRight();
+        void moveBy(int dx, int dy);
 
+        void setLocation(int x, int y);
         void setRandomLocation();
+        void setRandomLocation(SDL_Rect area);
         void resetTextureRect(int x = 0, int y = 0);
+        void setClip(const SpriteClip& clip);
 
+        virtual void save(Snapshot& snapshot);
+        virtual bool load(Snapshot& snapshot);
+        void reset();
         virtual void update() = 0;
 };
 
-class Player : public Entity {
+//An entity made of a fixed list of components held by value. Update calls each component by its own type,
+//so there is no virtual call per component and the compiler can inline them into one pass
+template<typename... Components>
+class Archetype : public Entity {
+    private:
+        tuple<Components...> _components;
+
+        template<typename C>
+        void updateComponent(C& component) {
+            if constexpr (C::visual) {
+                if (!_visible) {
+                    return;
+                }
+            }
+            component.C::update(this);
+        }
+    protected:
+        template<typename C>
+        C& component() { return get<C>(_components); }
+
+        void updateComponents() override { (updateComponent(get<Components>(_components)), ...); }
+        void saveComponents(Snapshot& snapshot) override { (get<Components>(_components).Components::save(snapshot), ...); }
+        bool loadComponents(Snapshot& snapshot) override { return (get<Components>(_components).Components::load(snapshot) && ...); }
+        void resetComponents() override { (get<Components>(_components).Components::reset(this), ...); }
+    public:
+        void addColliders(CollisionWorld& world) override {
+            Entity::addColliders(world);
+            (get<Components>(_components).Components::addColliders(this, world), ...);
+        }
+        void collide(const Collider& self, const Collider& other) override {
+            (get<Components>(_components).Components::collide(this, self, other), ...);
+        }
+};
+
+class Player : public Archetype<PlayerControlledMovement, Animation, Buffable, RangedWeapon, HealthBar, CoinCollector> {
     private:
-        int _numberOfSprites;
         int _animationSpeed;
     public:
         Player()=default;
-        Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight);
+        Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight);
 
         void update();
-        void centerPlayerToScreen();
+        void centerPlayerToWorld();
         void printStats();
 };
 
-class Enemy : public Entity {
+class Enemy : public Archetype<ChaseMovement, Animation, Buffable, HealthBar> {
     private:
-        int _numberOfSprites;
         int _animationSpeed;
     public:
         Enemy()=default;
-        Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight);
+        Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight);
 
         void update();
         void printStats();
 };
 
-class PowerUp : public Entity {
+class PowerUp : public Archetype<Animation> {
     private:
-        int _numberOfSprites;
         int _animationSpeed;
     public:
         string boostType;
@@ -115,32 +196,19 @@ class PowerUp : public Entity {
         int speedBoost = 4;
 
         PowerUp()=default;
-        PowerUp(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight, string type = "damage");
+        PowerUp(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight, string type = "damage");
 
         void update();
 };
 
-class Coin : public Entity {
+class Coin : public Archetype<Animation> {
     private:
-        int _numberOfSprites;
         int _animationSpeed;
         int coinsWorth = 1;
     public:
         Coin()=default;
-        Coin(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight);
-
-        void update();
-};
-
-class Projectile : public Entity {
-    private:
-        float _angle;
-        float _xVel;
-        float _yVel;
-        string _projectileType;
-    public:
-        Projectile()=default;
-        Projectile(SDL_Renderer* renderer, int x, int y, int w, int h, int screenWidth, int screenHeight, int target_x, int target_y, string type = "bullet");
+        Coin(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight);
 
         void update();
+        int getWorth() { return coinsWorth; }
 };
\ No newline at end of file
@@ -2,13 +2,28 @@
 
 #include <iostream>
 #include <vector>
+#include <map>
+#include <string>
 #include <algorithm>
+#include <type_traits>
 
 #include <sdl/SDL.h>
 #include <sdl/SDL_image.h>
 #include <sdl/SDL_mixer.h>
 #include <sdl/SDL_ttf.h>
 
+#include <headers/snapshot.h>
+#include <headers/flowField.h>
+#include <headers/steering.h>
+#include <headers/updateScheduler.h>
+#include <headers/camera.h>
+#include <headers/frameArena.h>
+#include <headers/eventBus.h>
+#include <headers/collision.h>
+#include <headers/obstacles.h>
+#include <headers/entityPool.h>
+#include <headers/combat.h>
+
 using namespace std;
 
 class Entity;
@@ -17,6 +32,22 @@ class PowerUp;
 class Enemy;
 class Coin;
 
+//Read only range over one of the manager's lists, valid until entities are next added or synced
+template<typename T>
+class EntityView {
+    private:
+        T* const* _begin;
+        T* const* _end;
+    public:
+        EntityView(const vector<T*>& list) : _begin(list.data()), _end(list.data() + list.size()) {};
+
+        T* const* begin() const { return _begin; }
+        T* const* end() const { return _end; }
+        size_t size() const { return _end - _begin; }
+        bool empty() const { return _begin == _end; }
+        T* operator[](size_t index) const { return _begin[index]; }
+};
+
 class EntityManager {
     private:
         int powerUpTimer = 0;
@@ -25,16 +56,49 @@ class EntityManager {
         int enemyTimer = 0;
         int EnemyThreshold = 600; // 10 seconds * 60 fps
 
-        Player* _player;
+        //Every entity in these lists comes from the manager's pools, removed ones go back to their pool at sync
+        Player* _player = nullptr;
         vector<PowerUp*> _powerUps;
         vector<Enemy*> _enemies;
         vector<Coin*> _coins;
+        vector<Entity*> _pendingRemovals; //Stay in their lists until sync, an entity may remove itself mid update
+        int _enemyCapacity = 256; //Most enemies alive at once, the wave director holds spawns back past this
+
+        //Removed entities go back to these instead of being deleted
+        EntityPool<Enemy> _enemyPool;
+        EntityPool<Coin> _coinPool;
+        map<string, EntityPool<PowerUp>> _powerUpPools; //By boost type, each type has its own sprites
+        int _enemyPrewarm = 256;
+        int _coinPrewarm = 128;
+        int _powerUpPrewarm = 4;
+
+        FlowField _flowField;
+        CrowdSteering _steering;
+        UpdateScheduler _scheduler;
+        Camera _camera;
+
+        SpatialGrid _cullGrid;
+        vector<Entity*> _cullEntities;
+        vector<float> _cullX;
+        vector<float> _cullY;
+
+        CollisionWorld _collisions;
+        ObstacleMap _obstacles;
+        CombatResolver _combat;
+
+        void addToCulling(Entity* entity);
+        bool isScheduled(Entity* entity, int index);
+        void updateScheduled(Entity* entity, int index);
+        bool restore(Snapshot& snapshot);
+        template<typename T>
+        vector<T*>& listOf();
 
         EntityManager() {};
     public:
         int coinsCollected = 0;
 
         EntityManager(const EntityManager&) = delete;
+        ~EntityManager();
 
         static EntityManager& get() {
             static EntityManager instance;
@@ -42,25 +106,74 @@ class EntityManager {
         }
         
         void initPlayer(Player* player) { _player = player; }
+        void initWorld(int screenWidth, int screenHeight, int worldWidth, int worldHeight);
+        bool loadObstacles(const string& filepath);
+        void initPools(SDL_Renderer* renderer, int fps, int worldWidth, int worldHeight);
+        void reportPools();
+        void clear();
 
         Player* getPlayer() { return _player; }
-        vector<PowerUp*> getPowerUpList() { return _powerUps; }
-        vector<Enemy*> getEnemiesList() { return _enemies; }
-        vector<Coin*> getCoinsList() { return _coins; }
+        FlowField& getFlowField() { return _flowField; }
+        CrowdSteering& getSteering() { return _steering; }
+        Camera& getCamera() { return _camera; }
+        CollisionWorld& getCollisions() { return _collisions; }
+        ObstacleMap& getObstacles() { return _obstacles; }
+        CombatResolver& getCombat() { return _combat; }
+        EntityView<PowerUp> getPowerUps() { return _powerUps; }
+        EntityView<Enemy> getEnemies() { return _enemies; }
+        int getEnemyCapacity() { return _enemyCapacity; }
+        EntityView<Coin> getCoins() { return _coins; }
 
-        void addToPowerUpList(PowerUp* powerUp) { _powerUps.push_back(powerUp) ; }
-        void addToEnemiesList(Enemy* enemy) { _enemies.push_back(enemy); }
-        void addToCoinsList(Coin* coin) { _coins.push_back(coin); }
+        //Visits every entity of one type that has not been removed, a visitor returning false stops early.
+        //Indexed with the count taken up front, so entities added during the loop are left for the next one
+        template<typename T, typename Visitor>
+        void forEach(Visitor visit) {
+            vector<T*>& list = listOf<T>();
+            for (size_t i = 0, count = list.size(); i < count; i++) {
+                T* entity = list[i];
+                if (entity->isRemoved()) {
+                    continue;
+                }
+                if constexpr (is_same<decltype(visit(entity)), bool>::value) {
+                    if (!visit(entity)) {
+                        return;
+                    }
+                }
+                else {
+                    visit(entity);
+                }
+            }
+        }
 
-        void removeFromPowerUpList(PowerUp* powerUp) { _powerUps.erase(remove(_powerUps.begin(), _powerUps.end(), powerUp), _powerUps.end()); }
-        void removeFromEnemiesList(Enemy* enemy) { _enemies.erase(remove(_enemies.begin(), _enemies.end(), enemy), _enemies.end()); }
-        void removeFromCoinsList(Coin* coin) { _coins.erase(remove(_coins.begin(), _coins.end(), coin), _coins.end()); }
+        //Taken from the pools, reset and already in their list, the caller only has to place them
+        Enemy* createEnemy();
+        Coin* createCoin();
+        PowerUp* createPowerUp(const string& type);
 
+        void removeEntity(Entity* entity);
+        void sync();
+
+        void updateCamera();
+        void updateVisibility();
+        void updateFlowField();
+        void updateSteering();
         void updatePlayer();
         void updatePowerUps();
         void updateEnemies();
         void updateCoins();
+        void updateCollisions();
 
         void updateEntities();
         void updateEntityEvents(SDL_Event event);
-};
\ No newline at end of file
+
+        //The world part of a snapshot, Game writes the header and its own state ahead of it
+        void saveSnapshot(Snapshot& snapshot);
+        bool loadSnapshot(Snapshot& snapshot, SDL_Renderer* renderer, int fps, int worldWidth, int worldHeight);
+};
+
+template<>
+inline vector<PowerUp*>& EntityManager::listOf<PowerUp>() { return _powerUps; }
+template<>
+inline vector<Enemy*>& EntityManager::listOf<Enemy>() { return _enemies; }
+template<>
+inline vector<Coin*>& EntityManager::listOf<Coin>() { return _coins; }
\ No newline at end of file
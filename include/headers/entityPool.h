@@ -0,0 +1,67 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+//Spare entities of one type. Constructing one loads its sprite sheet and fills the animation maps, so they are
+//built up front and reset when handed out. Live entities belong to the EntityManager lists until released
+template<typename T>
+class EntityPool {
+    private:
+        function<T*()> _create;
+        vector<T*> _free;
+        int _live = 0;
+        int _highWater = 0; //Most live at once, what the pool should be pre-warmed to
+        int _created = 0;
+    public:
+        EntityPool() {};
+        EntityPool(const EntityPool&) = delete;
+        ~EntityPool() { clear(); }
+
+        void init(function<T*()> create, int prewarm) {
+            _create = move(create);
+            _free.reserve(prewarm);
+            for (int i = 0; i < prewarm; i++) {
+                _free.push_back(_create());
+                _created++;
+            }
+        }
+
+        T* acquire() {
+            T* entity;
+            if (_free.empty()) {
+                //Past the pre-warmed count, still works but costs a full construction
+                entity = _create();
+                _created++;
+            }
+            else {
+                entity = _free.back();
+                _free.pop_back();
+            }
+            entity->reset();
+            _live++;
+            _highWater = max(_highWater, _live);
+            return entity;
+        }
+
+        void release(T* entity) {
+            _live--;
+            _free.push_back(entity);
+        }
+
+        void clear() {
+            for (T* entity : _free) {
+                delete entity;
+            }
+            _free.clear();
+        }
+
+        int getLive() { return _live; }
+        int getFree() { return _free.size(); }
+        int getHighWater() { return _highWater; }
+        int getCreated() { return _created; }
+};
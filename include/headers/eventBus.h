@@ -0,0 +1,64 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <functional>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+class Entity;
+
+enum GameEventType {
+    EnemyKilled,
+    PickupCollected,
+    ShotFired,
+    DamageDealt,
+    GameEventTypeCount
+};
+
+enum PickupType {
+    CoinPickup,
+    DamagePickup,
+    ArmorPickup,
+    SpeedPickup
+};
+
+//Plain data so it can be written into its slot from any thread, the entities stay alive until after dispatch
+struct GameEvent {
+    GameEventType type;
+    Entity* source = nullptr; //The shooter, collector or killer
+    Entity* target = nullptr; //The enemy hit or killed, or the pickup collected
+    SDL_Point position = {0, 0};
+    int amount = 0; //Damage dealt, or coins a pickup is worth
+    PickupType pickup = CoinPickup;
+};
+
+using GameEventHandler = function<void(const GameEvent* events, int count)>;
+
+//Gameplay events are appended during the update and handed to handlers in one batch per type at the sync point
+class EventBus {
+    private:
+        vector<GameEvent> _events; //Fixed size, slots are claimed with an atomic counter
+        SDL_atomic_t _count;
+        SDL_atomic_t _dropped;
+
+        vector<GameEvent> _batches[GameEventTypeCount];
+        vector<GameEventHandler> _handlers[GameEventTypeCount];
+
+        EventBus() { SDL_AtomicSet(&_count, 0); SDL_AtomicSet(&_dropped, 0); };
+    public:
+        EventBus(const EventBus&) = delete;
+
+        static EventBus& get() {
+            static EventBus instance;
+            return instance;
+        }
+
+        void init(int capacity);
+        void subscribe(GameEventType type, GameEventHandler handler);
+        void publish(const GameEvent& event);
+        void dispatch();
+        void clear();
+};
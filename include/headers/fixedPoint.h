@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cmath>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//16.16 fixed point, whole pixels in the top half and fractions of a pixel in the bottom.
+//Covers positions up to 32767 pixels, the world is well inside that
+typedef Sint32 Fixed;
+
+const int fixedShift = 16;
+const Fixed fixedOne = 1 << fixedShift;
+
+inline Fixed toFixed(int value) { return value * fixedOne; }
+inline Fixed toFixed(float value) { return (Fixed)lround(value * fixedOne); }
+inline int toPixels(Fixed value) { return value >> fixedShift; } //Rounds down, negative values included
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+class FlowField {
+    private:
+        static constexpr Uint8 noDirection = 255;
+
+        int _cellSize = 40;
+        int _columns = 0;
+        int _rows = 0;
+        int _targetCell = -1;
+
+        vector<Uint8> _obstacles;
+        vector<Uint8> _directions; //Read by enemies on the game thread, index into the neighbour table
+
+        //Shared with the worker thread, guarded by _mutex
+        SDL_Thread* _thread = nullptr;
+        SDL_mutex* _mutex = nullptr;
+        SDL_cond* _condition = nullptr;
+        bool _running = false;
+        bool _requested = false;
+        bool _finished = false;
+        int _requestedCell = -1;
+        vector<Uint8> _requestedObstacles;
+        vector<Uint8> _finishedDirections;
+
+        //Only touched by the worker thread
+        vector<int> _distances;
+        vector<int> _queue;
+
+        static int workerThread(void* data);
+        void compute(int targetCell, const vector<Uint8>& obstacles, vector<Uint8>& directions);
+        int cellAt(int x, int y);
+    public:
+        FlowField() {};
+        FlowField(const FlowField&) = delete;
+        ~FlowField();
+
+        void init(int width, int height, int cellSize);
+        void shutdown();
+        void setObstacle(SDL_Rect area, bool blocked = true);
+        void setTarget(int x, int y);
+        void update();
+
+        bool getDirection(int x, int y, int& dx, int& dy);
+        bool isReady() { return !_directions.empty(); }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Bump allocator for scratch data that only lives for one frame, everything is freed at once by reset
+class FrameArena {
+    private:
+        vector<char> _buffer; //Sized once at startup, never grows
+        size_t _used = 0;
+        size_t _peak = 0;
+        bool _warned = false; //Allocations that do not fit go to the heap, this is only reported once
+
+        FrameArena() {};
+    public:
+        FrameArena(const FrameArena&) = delete;
+
+        static FrameArena& get() {
+            static FrameArena instance;
+            return instance;
+        }
+
+        void init(size_t capacity);
+        void* allocate(size_t bytes, size_t alignment);
+        void deallocate(void* pointer);
+        void reset();
+
+        bool owns(const void* pointer) { return pointer >= _buffer.data() && pointer < _buffer.data() + _buffer.size(); }
+        size_t getUsed() { return _used; }
+        size_t getPeak() { return _peak; }
+        size_t getCapacity() { return _buffer.size(); }
+};
+
+//Lets standard containers take their memory from the frame arena, they must not outlive the frame
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    ArenaAllocator() {};
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {};
+
+    T* allocate(size_t count) { return static_cast<T*>(FrameArena::get().allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T* pointer, size_t count) { FrameArena::get().deallocate(pointer); }
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return true; }
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) { return false; }
+
+template<typename T>
+using FrameVector = vector<T, ArenaAllocator<T>>;
+
+//Number of heap allocations made so far, only counted in builds with -DALLOCATION_DEBUG
+int getHeapAllocations();
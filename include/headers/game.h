@@ -15,6 +15,14 @@
 #include "entityManager.h"
 #include "entity.h"
 #include "command.h"
+#include "snapshot.h"
+#include "tileMap.h"
+#include "assets.h"
+#include "resources.h"
+#include "frameArena.h"
+#include "eventBus.h"
+#include "audio.h"
+#include "spawnDirector.h"
 
 using namespace std;
 
@@ -22,43 +30,72 @@ class Game {
     private:
         const int _fps = 60;
         const int _frameDelay = 1000 / _fps;
+        const double _uploadBudget = 2; //Milliseconds per frame spent turning loaded images into textures
+        const size_t _frameArenaSize = 256 * 1024;
+        const int _mixerChannels = 16;
         Uint32 _frameStart;
         int _frameTime;
 
         int _screenWidth;
         int _screenHeight;
+        int _worldWidth;
+        int _worldHeight;
+        int _worldScale = 10; //World is this many screens wide and tall
         int _speed = 5;
         SDL_Color black = {0, 0, 0};
 
-        SDL_Window* _window;
-        SDL_Renderer* _renderer;
+        WindowHandle _window;
+        RendererHandle _renderer;
         bool running = true;
         vector<SDL_KeyCode> movementKeys = {SDLK_w, SDLK_a, SDLK_s, SDLK_d};
 
         int powerUpTimer = 0;
         int powerUpThreshold = 3 * _fps;
 
-        int enemyTimer = 0;
-        int enemyThreshold = 5 * _fps;
+        SpawnDirector _director;
+        const double _spawnBudget = 1; //Milliseconds per frame spent constructing enemies from the wave script
 
-        TTF_Font* font;
-        SDL_Surface* surfaceMessage;
-        SDL_Texture* message;
+        FontAsset* font;
+        SurfaceHandle surfaceMessage;
+        TextureHandle message;
         SDL_Rect messagePosition;
+        int shownCoins = -1; //The message is only rendered again when the coin count changes
 
-        SDL_Texture* coin;
+        TextureAsset* coin;
         SDL_Rect coinPosition;
 
-        Mix_Music* backgroundMusic;
-        bool musicPlaying = false;
+        TileMap _background;
+
+        SoundAsset* gunshotSound;
+        SoundAsset* coinSound;
+        SoundAsset* damageSound;
+        SoundAsset* armorSound;
+        SoundAsset* speedSound;
+
+        int allocationReportTimer = 0;
+        int allocationsAtReport = 0;
+
+        Snapshot _snapshot; //Captured every frame, written out on F5 and restored on F9
+        const char* _snapshotPath = "snapshot.bin";
 
         void gameLoop();
         void handleEvents();
         void handleSpawning();
         void handleUI();
-
+        void reportAllocations();
+        void captureSnapshot();
+        void saveSnapshot();
+        void loadSnapshot();
+
+        void preloadAssets();
+        void subscribeToEvents();
+        void onEnemiesKilled(const GameEvent* events, int count);
+        void onPickupsCollected(const GameEvent* events, int count);
+        void onShotsFired(const GameEvent* events, int count);
         void spawnPowerUp(int type = 0);
-        void spawnEnemy(int type = 0);
+        void spawnEnemy(int type = 0, int screens = 3);
+        void spawnFromScript(const string& type, int screens);
+        SDL_Rect spawnArea(int screens);
 
         bool collision(SDL_Rect a, SDL_Rect b);
         void display();
@@ -70,6 +107,6 @@ class Game {
         SDL_Keycode lastKeyReleased;
 
         Game(const char* title, int x, int y, int w, int h, Uint32 flags);
-        ~Game() {};
+        ~Game();
         void run();
 };
\ No newline at end of file
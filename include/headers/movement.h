@@ -0,0 +1,37 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include <sdl/SDL.h>
+
+#include <headers/fixedPoint.h>
+#include <headers/snapshot.h>
+
+using namespace std;
+
+//Positions and velocities of many small movers in packed fixed point arrays. Moving them is plain integer adds
+//in a loop, so fractions of a pixel are never lost and results are the same on every machine
+class MovementBuffer {
+    private:
+        vector<Fixed> _x;
+        vector<Fixed> _y;
+        vector<Fixed> _xVel;
+        vector<Fixed> _yVel;
+        int _width = 0;
+        int _height = 0;
+    public:
+        MovementBuffer() {};
+        MovementBuffer(int width, int height) : _width(width), _height(height) {};
+
+        void add(int x, int y, float xVel, float yVel);
+        void remove(int index);
+        void clear();
+        void move();
+
+        int size() { return _x.size(); }
+        SDL_Rect getRect(int index) { return {toPixels(_x[index]), toPixels(_y[index]), _width, _height}; }
+
+        void save(Snapshot& snapshot);
+        bool load(Snapshot& snapshot);
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+#include <headers/aabbTree.h>
+#include <headers/camera.h>
+
+using namespace std;
+
+//Walls and props of the level. Movement and projectiles are resolved against them through an AABB tree,
+//so each check only looks at the few walls near the mover
+class ObstacleMap {
+    private:
+        AabbTree _tree;
+        vector<SDL_Rect> _walls;
+        SDL_Color _colour = {120, 112, 104, 255};
+    public:
+        ObstacleMap() {};
+
+        bool load(const string& filepath);
+        void add(SDL_Rect wall);
+        void clear();
+
+        bool overlaps(SDL_Rect box);
+        int slide(SDL_Rect box, int distance, bool horizontal);
+        bool raycast(SDL_FPoint from, SDL_FPoint to, float& fraction);
+        void draw(SDL_Renderer* renderer, Camera& camera);
+
+        const vector<SDL_Rect>& getWalls() { return _walls; }
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <iostream>
+
+#include <sdl/SDL.h>
+#include <sdl/SDL_image.h>
+#include <sdl/SDL_mixer.h>
+#include <sdl/SDL_ttf.h>
+
+using namespace std;
+
+enum ResourceKind {
+    TextureResource,
+    SurfaceResource,
+    ChunkResource,
+    MusicResource,
+    FontResource,
+    RendererResource,
+    WindowResource,
+    EntityResource,
+    ResourceKindCount
+};
+
+//Counts live resources of each kind when built with -DRESOURCE_DEBUG, and reports any still alive at exit
+class ResourceTracker {
+    private:
+        static SDL_atomic_t _live[ResourceKindCount];
+    public:
+        static void add(ResourceKind kind, int amount) {
+#ifdef RESOURCE_DEBUG
+            SDL_AtomicAdd(&_live[kind], amount);
+#endif
+        }
+        static int live(ResourceKind kind) { return SDL_AtomicGet(&_live[kind]); }
+        static bool report();
+};
+
+//Move only owner of one SDL resource, destroyed with the matching SDL call when it goes out of scope
+template<typename T, void (*Destroy)(T*), ResourceKind Kind>
+class Handle {
+    private:
+        T* _resource = nullptr;
+    public:
+        Handle() {};
+        explicit Handle(T* resource) { reset(resource); }
+        ~Handle() { reset(); }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle(Handle&& other) noexcept : _resource(other._resource) { other._resource = nullptr; }
+        Handle& operator=(Handle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                _resource = other._resource;
+                other._resource = nullptr;
+            }
+            return *this;
+        }
+
+        void reset(T* resource = nullptr) {
+            if (_resource != nullptr) {
+                Destroy(_resource);
+                ResourceTracker::add(Kind, -1);
+            }
+            _resource = resource;
+            if (_resource != nullptr) {
+                ResourceTracker::add(Kind, 1);
+            }
+        }
+
+        T* get() const { return _resource; }
+        T* operator->() const { return _resource; }
+        explicit operator bool() const { return _resource != nullptr; }
+};
+
+using TextureHandle = Handle<SDL_Texture, SDL_DestroyTexture, TextureResource>;
+using SurfaceHandle = Handle<SDL_Surface, SDL_FreeSurface, SurfaceResource>;
+using ChunkHandle = Handle<Mix_Chunk, Mix_FreeChunk, ChunkResource>;
+using MusicHandle = Handle<Mix_Music, Mix_FreeMusic, MusicResource>;
+using FontHandle = Handle<TTF_Font, TTF_CloseFont, FontResource>;
+using RendererHandle = Handle<SDL_Renderer, SDL_DestroyRenderer, RendererResource>;
+using WindowHandle = Handle<SDL_Window, SDL_DestroyWindow, WindowResource>;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+class Snapshot {
+    private:
+        vector<char> _buffer; //Only grows, _size is how much of it holds the snapshot
+        size_t _size = 0;
+        size_t _readOffset = 0;
+        bool _overran = false; //Something read past the end, what came back is zeroes rather than saved state
+
+        char* reserve(size_t bytes) {
+            if (_size + bytes > _buffer.size()) {
+                _buffer.resize(max(_buffer.size() * 2, _size + bytes));
+            }
+            char* destination = _buffer.data() + _size;
+            _size += bytes;
+            return destination;
+        }
+    public:
+        static constexpr Uint32 magic = 0x50414E53; //"SNAP"
+        static constexpr Uint32 version = 6;
+
+        Snapshot() {};
+
+        void clear() { _size = 0; _readOffset = 0; _overran = false; } //Keeps the buffer so per frame snapshots stop allocating
+        size_t size() const { return _size; }
+        size_t remaining() const { return _size - _readOffset; } //Bytes left to read
+        bool overran() const { return _overran; }
+
+        template<typename T>
+        void write(const T& value) {
+            static_assert(is_trivially_copyable<T>::value, "Snapshot can only write trivially copyable types");
+            memcpy(reserve(sizeof(T)), &value, sizeof(T));
+        }
+
+        template<typename T>
+        T read() {
+            static_assert(is_trivially_copyable<T>::value, "Snapshot can only read trivially copyable types");
+            T value{};
+            if (_readOffset + sizeof(T) <= _size) {
+                memcpy(&value, _buffer.data() + _readOffset, sizeof(T));
+                _readOffset += sizeof(T);
+            }
+            else {
+                _overran = true;
+            }
+            return value;
+        }
+
+        void writeString(const string& text);
+        string readString();
+
+        void writeHeader();
+        bool readHeader();
+
+        bool saveToFile(const char* filepath) const;
+        bool loadFromFile(const char* filepath);
+};
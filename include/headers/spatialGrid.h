@@ -0,0 +1,62 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Uniform grid over points, rebuilt each frame with a counting sort so it never allocates once warm
+class SpatialGrid {
+    private:
+        int _cellSize = 64;
+        int _columns = 1;
+        int _rows = 1;
+
+        vector<int> _cellStart; //Items of cell c are _items[_cellStart[c]] up to _items[_cellStart[c + 1]]
+        vector<int> _cellOf;
+        vector<int> _items;
+
+        int columnAt(float x) { return min(_columns - 1, max(0, (int)x / _cellSize)); }
+        int rowAt(float y) { return min(_rows - 1, max(0, (int)y / _cellSize)); }
+    public:
+        SpatialGrid() {};
+
+        void init(int width, int height, int cellSize);
+        void build(const float* x, const float* y, int count);
+
+        int getCellSize() { return _cellSize; }
+        const vector<int>& getItems() { return _items; } //Item ids in cell order, valid until the next build
+
+        template<typename Visitor>
+        void query(float minX, float minY, float maxX, float maxY, Visitor visit) {
+            int lastColumn = columnAt(maxX);
+            int lastRow = rowAt(maxY);
+            for (int row = rowAt(minY); row <= lastRow; row++) {
+                for (int column = columnAt(minX); column <= lastColumn; column++) {
+                    int cell = row * _columns + column;
+                    for (int i = _cellStart[cell]; i < _cellStart[cell + 1]; i++) {
+                        visit(_items[i]);
+                    }
+                }
+            }
+        }
+
+        //Same area as query, but hands over positions in getItems() instead of ids. The cells of one row are
+        //next to each other there, so each row of the area is a single run from begin up to end
+        template<typename Visitor>
+        void queryRuns(float minX, float minY, float maxX, float maxY, Visitor visit) {
+            int firstColumn = columnAt(minX);
+            int lastColumn = columnAt(maxX);
+            int lastRow = rowAt(maxY);
+            for (int row = rowAt(minY); row <= lastRow; row++) {
+                int begin = _cellStart[row * _columns + firstColumn];
+                int end = _cellStart[row * _columns + lastColumn + 1];
+                if (begin < end) {
+                    visit(begin, end);
+                }
+            }
+        }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cmath>
+
+#include <sdl/SDL.h>
+
+#include <headers/snapshot.h>
+
+using namespace std;
+
+enum RampCurve {
+    LinearRamp,
+    EaseInRamp, //Starts slow and speeds up
+    EaseOutRamp //Starts fast and tails off
+};
+
+//Spawns a wave script over time. Each group's spawns follow its ramp curve, and any the frame's time budget
+//cannot fit are carried over to the next frame. Spawns also wait while the live cap is reached
+class SpawnDirector {
+    public:
+        //Where the script has got to, read from a snapshot and only applied once the rest of it has loaded
+        struct State {
+            int currentWave = 0;
+            int waveFrame = 0;
+            int waveNumber = 0;
+            float countScale = 1;
+            vector<int> spawned; //Per group of the current wave
+        };
+    private:
+        struct SpawnGroup {
+            string type;
+            int count = 0;
+            int screens = 3;
+            int frames = 1;
+            RampCurve curve = LinearRamp;
+            int spawned = 0;
+        };
+
+        struct Wave {
+            int delayFrames = 0;
+            vector<SpawnGroup> groups;
+        };
+
+        vector<Wave> _waves;
+        int _fps = 60;
+        int _loopPercent = 0; //0 stops after the last wave
+        float _countScale = 1;
+        float _maxCountScale = 4; //Looping stops growing the waves past this
+
+        int _liveCap = 0; //0 leaves live enemies uncapped
+        function<int()> _liveCount;
+
+        int _currentWave = 0;
+        int _waveFrame = 0; //Frames since the current wave started spawning, negative while waiting out its delay
+        int _waveNumber = 0; //Counts up through loops
+
+        function<void(const string& type, int screens)> _spawn;
+
+        void startWave(int wave);
+        int targetCount(const SpawnGroup& group);
+    public:
+        SpawnDirector() {};
+
+        void init(int fps, function<void(const string& type, int screens)> spawn);
+        bool load(const string& filepath);
+        void setLiveCap(int cap, function<int()> liveCount);
+        void update(double budgetMs);
+
+        void saveState(Snapshot& snapshot);
+        bool readState(Snapshot& snapshot, State& state);
+        void setState(const State& state);
+
+        int getWaveNumber() { return _waveNumber; }
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <memory>
+
+#include <sdl/SDL.h>
+#include <sdl/SDL_image.h>
+
+#include <headers/assets.h>
+
+using namespace std;
+
+struct SpriteClip {
+    TextureAsset* texture = nullptr;
+    SDL_Rect frame = {0, 0, 0, 0}; //First frame of the clip, the rest follow to the right
+    int frames = 1;
+};
+
+//Frames cut out of shared sheet textures as rects, described by a small text file next to the sheets
+class SpriteSheet {
+    private:
+        int _frameWidth = 0;
+        int _frameHeight = 0;
+        map<string, TextureAsset*> _textures; //One per image, shared by every clip on it
+        map<string, SpriteClip> _clips;
+
+        static map<string, unique_ptr<SpriteSheet>> _loaded;
+
+        bool loadDescriptor(const string& filepath);
+    public:
+        SpriteSheet() {};
+
+        static SpriteSheet* load(const string& filepath);
+
+        SpriteClip getClip(const string& state, const string& direction);
+        int getFrameWidth() { return _frameWidth; }
+        int getFrameHeight() { return _frameHeight; }
+};
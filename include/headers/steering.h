@@ -0,0 +1,57 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include <sdl/SDL.h>
+
+#include <headers/spatialGrid.h>
+#include <headers/flowField.h>
+
+using namespace std;
+
+//Seek, separation and alignment for every chasing enemy at once, stored as packed arrays so the
+//per neighbour and per agent maths can run four lanes at a time. Each frame the agents are also copied
+//into grid cell order, so the neighbours in a row of cells are one run of those arrays
+class CrowdSteering {
+    private:
+        float _neighbourRadius = 48;
+        float _separationWeight = 24;
+        float _alignmentWeight = 0.1f;
+        float _seekWeight = 0.2f;
+
+        int _count = 0;
+        vector<float> _x;
+        vector<float> _y;
+        vector<float> _velocityX;
+        vector<float> _velocityY;
+        vector<float> _maxSpeed;
+        vector<float> _forceX;
+        vector<float> _forceY;
+        vector<bool> _steered; //Agents the scheduler skips this frame keep their velocity but still push their neighbours
+
+        //The same agents in cell order, with four spare lanes at the end for the last partial load
+        vector<float> _cellX;
+        vector<float> _cellY;
+        vector<float> _cellVelocityX;
+        vector<float> _cellVelocityY;
+        vector<float> _cellAgent; //Agent index as a float, compared in lanes beside the positions
+
+        SpatialGrid _grid;
+
+        void sortByCell();
+        void accumulateRun(int agent, int begin, int end, float& separationX, float& separationY, float& alignmentX, float& alignmentY, float& count);
+        void integrate();
+    public:
+        CrowdSteering() {};
+
+        void init(int width, int height);
+        void clear() { _count = 0; }
+        void addAgent(float x, float y, SDL_FPoint velocity, float maxSpeed, bool steered = true);
+        void update(FlowField& field, float targetX, float targetY);
+
+        int getCount() { return _count; }
+        SDL_FPoint getVelocity(int agent) { return {_velocityX[agent], _velocityY[agent]}; }
+};
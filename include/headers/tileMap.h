@@ -0,0 +1,53 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+#include <sdl/SDL_image.h>
+
+#include <headers/camera.h>
+#include <headers/assets.h>
+#include <headers/resources.h>
+
+using namespace std;
+
+//Background tiles grouped into square chunks, each chunk is drawn once into its own texture and
+//streamed in and out around the camera
+class TileMap {
+    private:
+        SDL_Renderer* _renderer = nullptr;
+        int _tileSize = 40;
+        int _chunkTiles = 16;
+        int _chunkSize = 640;
+        int _columns = 0;
+        int _rows = 0;
+        int _chunkColumns = 0;
+        int _chunkRows = 0;
+        int _prefetchPerFrame = 1; //Chunks just outside the view are built a few at a time
+
+        vector<Uint8> _tiles;
+        vector<TextureAsset*> _tileTextures; //nullptr for flat colour tiles
+        vector<int> _tileVersions; //Texture versions the cached chunks were drawn from
+        vector<SDL_Color> _tileColours;
+        map<int, TextureHandle> _chunks;
+
+        TextureHandle buildChunk(int chunkColumn, int chunkRow);
+        void checkReloads();
+        void drawTile(int tile, SDL_Rect destination);
+    public:
+        TileMap() {};
+        TileMap(const TileMap&) = delete;
+        ~TileMap();
+
+        void init(SDL_Renderer* renderer, int worldWidth, int worldHeight, int tileSize, int chunkTiles);
+        void addTile(const char* filepath);
+        void addTile(SDL_Color colour);
+        void generate();
+
+        void draw(Camera& camera);
+        void invalidate();
+        int getCachedChunks() { return _chunks.size(); }
+};
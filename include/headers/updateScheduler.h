@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include <sdl/SDL.h>
+
+using namespace std;
+
+//Decides how often an entity is ticked from how far it is from the player and whether it can be seen
+class UpdateScheduler {
+    private:
+        int _frame = 0;
+        SDL_Point _focus = {0, 0};
+
+        int _nearDistance = 600;
+        int _farDistance = 1400;
+        int _midInterval = 2;
+        int _farInterval = 4;
+    public:
+        UpdateScheduler() {};
+
+        void beginFrame(SDL_Point focus);
+        int getInterval(SDL_Rect position, bool visible);
+        bool shouldUpdate(int index, int interval) { return (_frame + index) % interval == 0; }
+
+        int getFrame() { return _frame; }
+        void setFrame(int frame) { _frame = frame; }
+};
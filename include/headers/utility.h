@@ -11,7 +11,12 @@
 #include <sdl/SDL_mixer.h>
 #include <sdl/SDL_ttf.h>
 
+#include <headers/resources.h>
+
 using namespace std;
 
-SDL_Texture* loadTexture(SDL_Renderer* renderer, const char* filepath);
-TTF_Font* loadFont(const char* filepath, int size);
\ No newline at end of file
+TextureHandle loadTexture(SDL_Renderer* renderer, const char* filepath);
+FontHandle loadFont(const char* filepath, int size);
+int randomInt(int min, int max);
+Uint32 getRandomState();
+void setRandomState(Uint32 state);
@@ -0,0 +1,218 @@
+#include <headers/aabbTree.h>
+
+int AabbTree::allocate() {
+    if (_free < 0) {
+        _nodes.push_back(Node());
+        return _nodes.size() - 1;
+    }
+    int index = _free;
+    _free = _nodes[index].parent;
+    _nodes[index] = Node();
+    return index;
+}
+
+void AabbTree::release(int index) {
+    _nodes[index].parent = _free;
+    _nodes[index].left = -1;
+    _nodes[index].data = -1;
+    _free = index;
+}
+
+int AabbTree::insert(SDL_Rect box, int data) {
+    int leaf = allocate();
+    _nodes[leaf].tight = box;
+    _nodes[leaf].box = {box.x - _margin, box.y - _margin, box.w + _margin * 2, box.h + _margin * 2};
+    _nodes[leaf].data = data;
+    insertLeaf(leaf);
+    _leaves++;
+    return leaf;
+}
+
+void AabbTree::remove(int proxy) {
+    removeLeaf(proxy);
+    release(proxy);
+    _leaves--;
+}
+
+bool AabbTree::move(int proxy, SDL_Rect box) {
+    _nodes[proxy].tight = box;
+    if (contains(_nodes[proxy].box, box)) {
+        return false;
+    }
+    removeLeaf(proxy);
+    _nodes[proxy].box = {box.x - _margin, box.y - _margin, box.w + _margin * 2, box.h + _margin * 2};
+    insertLeaf(proxy);
+    return true;
+}
+
+void AabbTree::clear() {
+    _nodes.clear();
+    _root = -1;
+    _free = -1;
+    _leaves = 0;
+}
+
+void AabbTree::insertLeaf(int leaf) {
+    if (_root < 0) {
+        _root = leaf;
+        _nodes[leaf].parent = -1;
+        return;
+    }
+
+    //Walk down towards whichever child grows the least, stopping when pairing here is cheaper than either
+    SDL_Rect box = _nodes[leaf].box;
+    int index = _root;
+    while (!isLeaf(index)) {
+        const Node& node = _nodes[index];
+        int combined = perimeter(unite(node.box, box));
+        int cost = 2 * combined;
+        int inherited = 2 * (combined - perimeter(node.box));
+
+        int leftCost = perimeter(unite(_nodes[node.left].box, box)) + inherited;
+        if (!isLeaf(node.left)) {
+            leftCost -= perimeter(_nodes[node.left].box);
+        }
+        int rightCost = perimeter(unite(_nodes[node.right].box, box)) + inherited;
+        if (!isLeaf(node.right)) {
+            rightCost -= perimeter(_nodes[node.right].box);
+        }
+
+        if (cost < leftCost && cost < rightCost) {
+            break;
+        }
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    int sibling = index;
+    int oldParent = _nodes[sibling].parent;
+    int newParent = allocate();
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = unite(_nodes[sibling].box, box);
+    _nodes[newParent].left = sibling;
+    _nodes[newParent].right = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent < 0) {
+        _root = newParent;
+    }
+    else if (_nodes[oldParent].left == sibling) {
+        _nodes[oldParent].left = newParent;
+    }
+    else {
+        _nodes[oldParent].right = newParent;
+    }
+    refit(oldParent);
+}
+
+void AabbTree::removeLeaf(int leaf) {
+    if (leaf == _root) {
+        _root = -1;
+        return;
+    }
+
+    int parent = _nodes[leaf].parent;
+    int grandParent = _nodes[parent].parent;
+    int sibling = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+    //The sibling takes the parent's place
+    _nodes[sibling].parent = grandParent;
+    if (grandParent < 0) {
+        _root = sibling;
+    }
+    else if (_nodes[grandParent].left == parent) {
+        _nodes[grandParent].left = sibling;
+    }
+    else {
+        _nodes[grandParent].right = sibling;
+    }
+    release(parent);
+    refit(grandParent);
+}
+
+void AabbTree::refit(int index) {
+    while (index >= 0) {
+        Node& node = _nodes[index];
+        node.box = unite(_nodes[node.left].box, _nodes[node.right].box);
+        index = node.parent;
+    }
+}
+
+int AabbTree::raycast(SDL_FPoint from, SDL_FPoint to, float& fraction) {
+    int hit = -1;
+    if (_root < 0) {
+        return hit;
+    }
+    SDL_FPoint delta = {to.x - from.x, to.y - from.y};
+    float best = 1;
+
+    _stack.clear();
+    _stack.push_back(_root);
+    while (!_stack.empty()) {
+        int index = _stack.back();
+        _stack.pop_back();
+        const Node& node = _nodes[index];
+
+        //Branches are only opened when the ray reaches them before the nearest hit so far
+        float entry = 0;
+        if (!rayHits(node.box, from, delta, best, entry)) {
+            continue;
+        }
+        if (isLeaf(index)) {
+            if (rayHits(node.tight, from, delta, best, entry)) {
+                best = entry;
+                hit = index;
+            }
+        }
+        else {
+            _stack.push_back(node.left);
+            _stack.push_back(node.right);
+        }
+    }
+    fraction = best;
+    return hit;
+}
+
+SDL_Rect AabbTree::unite(const SDL_Rect& a, const SDL_Rect& b) {
+    int left = min(a.x, b.x);
+    int top = min(a.y, b.y);
+    int right = max(a.x + a.w, b.x + b.w);
+    int bottom = max(a.y + a.h, b.y + b.h);
+    return {left, top, right - left, bottom - top};
+}
+
+bool AabbTree::contains(const SDL_Rect& outer, const SDL_Rect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+        inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+}
+
+bool AabbTree::rayHits(const SDL_Rect& box, SDL_FPoint from, SDL_FPoint delta, float maxFraction, float& fraction) {
+    float origin[2] = {from.x, from.y};
+    float direction[2] = {delta.x, delta.y};
+    float low[2] = {(float)box.x, (float)box.y};
+    float high[2] = {(float)(box.x + box.w), (float)(box.y + box.h)};
+    float enter = 0;
+    float exit = maxFraction;
+
+    //Slab test, the ray is inside the box where it is between both pairs of edges at once
+    for (int axis = 0; axis < 2; axis++) {
+        if (fabs(direction[axis]) < 0.0001f) {
+            if (origin[axis] < low[axis] || origin[axis] >= high[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float entering = (low[axis] - origin[axis]) / direction[axis];
+        float leaving = (high[axis] - origin[axis]) / direction[axis];
+        if (entering > leaving) {
+            swap(entering, leaving);
+        }
+        enter = max(enter, entering);
+        exit = min(exit, leaving);
+        if (enter > exit) {
+            return false;
+        }
+    }
+    fraction = enter;
+    return true;
+}
@@ -0,0 +1,259 @@
+#include <headers/assetWatcher.h>
+
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <dirent.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#endif
+
+AssetWatcher::~AssetWatcher() {
+    if (_thread != nullptr) {
+        SDL_LockMutex(_mutex);
+        _running = false;
+        SDL_UnlockMutex(_mutex);
+        SDL_WaitThread(_thread, NULL);
+    }
+#ifdef __linux__
+    if (_inotify != -1) {
+        close(_inotify);
+    }
+#elif defined(_WIN32)
+    for (void* handle : _directoryHandles) {
+        CloseHandle(handle);
+    }
+#endif
+    if (_mutex != nullptr) {
+        SDL_DestroyMutex(_mutex);
+    }
+}
+
+void AssetWatcher::start(const vector<string>& directories) {
+    _directories = directories;
+    _mutex = SDL_CreateMutex();
+
+#ifdef __linux__
+    _inotify = inotify_init1(IN_NONBLOCK);
+    if (_inotify == -1) {
+        cout << "inotify unavailable, asset changes will be polled" << endl;
+        return;
+    }
+    for (const string& directory : _directories) {
+        addWatches(directory);
+    }
+
+    _running = true;
+    _thread = SDL_CreateThread(watchThread, "AssetWatcher", this);
+    if (_thread == nullptr) {
+        cout << "Failed to start asset watcher thread: " << SDL_GetError() << endl;
+    }
+#elif defined(_WIN32)
+    //One wait covers every directory, so there can be at most MAXIMUM_WAIT_OBJECTS of them
+    for (const string& directory : _directories) {
+        if (_directoryHandles.size() == MAXIMUM_WAIT_OBJECTS) {
+            cout << "Too many asset directories to watch, changes in " << directory << " will not be seen" << endl;
+            continue;
+        }
+        HANDLE handle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+        if (handle == INVALID_HANDLE_VALUE) {
+            cout << "Asset directory could not be watched: " << directory << " Error: " << GetLastError() << endl;
+            continue;
+        }
+        _watches[_directoryHandles.size()] = directory;
+        _directoryHandles.push_back(handle);
+    }
+    if (_directoryHandles.empty()) {
+        cout << "No asset directories could be watched, asset changes will be polled" << endl;
+        return;
+    }
+
+    _running = true;
+    _thread = SDL_CreateThread(watchThread, "AssetWatcher", this);
+    if (_thread == nullptr) {
+        cout << "Failed to start asset watcher thread: " << SDL_GetError() << endl;
+    }
+#endif
+}
+
+void AssetWatcher::addWatches(const string& directory) {
+#ifdef __linux__
+    //inotify is not recursive, so every sub directory gets its own watch
+    int watch = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch != -1) {
+        _watches[watch] = directory;
+    }
+
+    DIR* dir = opendir(directory.c_str());
+    if (dir == NULL) {
+        return;
+    }
+    while (dirent* entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+            addWatches(path);
+        }
+    }
+    closedir(dir);
+#endif
+}
+
+int AssetWatcher::watchThread(void* data) {
+#ifdef __linux__
+    AssetWatcher* watcher = static_cast<AssetWatcher*>(data);
+    alignas(inotify_event) char buffer[4096];
+
+    while (true) {
+        SDL_LockMutex(watcher->_mutex);
+        bool running = watcher->_running;
+        SDL_UnlockMutex(watcher->_mutex);
+        if (!running) {
+            break;
+        }
+
+        //Wakes at least every quarter second so shutting down never waits long
+        pollfd descriptor = {watcher->_inotify, POLLIN, 0};
+        if (::poll(&descriptor, 1, 250) <= 0) {
+            continue;
+        }
+
+        ssize_t length = read(watcher->_inotify, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;) {
+            inotify_event* event = reinterpret_cast<inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0 || watcher->_watches.find(event->wd) == watcher->_watches.end()) {
+                continue;
+            }
+            SDL_LockMutex(watcher->_mutex);
+            watcher->_changed.push_back(watcher->_watches[event->wd] + "/" + event->name);
+            SDL_UnlockMutex(watcher->_mutex);
+        }
+    }
+#elif defined(_WIN32)
+    AssetWatcher* watcher = static_cast<AssetWatcher*>(data);
+    DWORD count = watcher->_directoryHandles.size();
+    DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME;
+
+    //Each directory has its own read in flight, its event is set when that read completes
+    vector<OVERLAPPED> overlapped(count);
+    vector<HANDLE> events(count);
+    vector<vector<DWORD>> buffers(count, vector<DWORD>(1024)); //FILE_NOTIFY_INFORMATION has to be DWORD aligned
+    for (DWORD i = 0; i < count; i++) {
+        events[i] = CreateEventA(NULL, TRUE, FALSE, NULL);
+        overlapped[i] = {};
+        overlapped[i].hEvent = events[i];
+        ReadDirectoryChangesW(watcher->_directoryHandles[i], buffers[i].data(), buffers[i].size() * sizeof(DWORD), TRUE, filter, NULL, &overlapped[i], NULL);
+    }
+
+    while (true) {
+        SDL_LockMutex(watcher->_mutex);
+        bool running = watcher->_running;
+        SDL_UnlockMutex(watcher->_mutex);
+        if (!running) {
+            break;
+        }
+
+        //Wakes at least every quarter second so shutting down never waits long
+        DWORD result = WaitForMultipleObjects(count, events.data(), FALSE, 250);
+        if (result == WAIT_FAILED) {
+            cout << "Asset watcher stopped, Error: " << GetLastError() << endl;
+            break;
+        }
+        if (result >= WAIT_OBJECT_0 + count) {
+            continue;
+        }
+        DWORD i = result - WAIT_OBJECT_0;
+
+        //A length of 0 means the buffer overflowed and that batch of changes is lost
+        DWORD length = 0;
+        if (GetOverlappedResult(watcher->_directoryHandles[i], &overlapped[i], &length, FALSE) && length > 0) {
+            char* buffer = reinterpret_cast<char*>(buffers[i].data());
+            for (DWORD offset = 0;;) {
+                FILE_NOTIFY_INFORMATION* info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(buffer + offset);
+                if (info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+                    int wideLength = info->FileNameLength / sizeof(WCHAR);
+                    int size = WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, NULL, 0, NULL, NULL);
+                    string name(size, '\0');
+                    WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, &name[0], size, NULL, NULL);
+                    replace(name.begin(), name.end(), '\\', '/');
+                    string filepath = watcher->_watches[i] + "/" + name;
+
+                    //Saving usually writes a file more than once, each change only needs one reload
+                    SDL_LockMutex(watcher->_mutex);
+                    if (find(watcher->_changed.begin(), watcher->_changed.end(), filepath) == watcher->_changed.end()) {
+                        watcher->_changed.push_back(filepath);
+                    }
+                    SDL_UnlockMutex(watcher->_mutex);
+                }
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                offset += info->NextEntryOffset;
+            }
+        }
+
+        ResetEvent(events[i]);
+        ReadDirectoryChangesW(watcher->_directoryHandles[i], buffers[i].data(), buffers[i].size() * sizeof(DWORD), TRUE, filter, NULL, &overlapped[i], NULL);
+    }
+
+    //The reads have to be finished before their buffers go away
+    for (DWORD i = 0; i < count; i++) {
+        DWORD length = 0;
+        CancelIo(watcher->_directoryHandles[i]);
+        GetOverlappedResult(watcher->_directoryHandles[i], &overlapped[i], &length, TRUE);
+        CloseHandle(events[i]);
+    }
+#endif
+    return 0;
+}
+
+long long AssetWatcher::modifiedTime(const string& filepath) {
+    struct stat info;
+    if (stat(filepath.c_str(), &info) != 0) {
+        return 0;
+    }
+    return (long long)info.st_mtime;
+}
+
+void AssetWatcher::poll(const FrameVector<const string*>& filepaths) {
+    if (_thread != nullptr || _mutex == nullptr) {
+        return;
+    }
+
+    //The first sighting of a file only records its time, after that any change is reported
+    for (const string* filepath : filepaths) {
+        long long modified = modifiedTime(*filepath);
+        auto known = _modified.find(*filepath);
+        if (known == _modified.end()) {
+            _modified[*filepath] = modified;
+        }
+        else if (known->second != modified) {
+            known->second = modified;
+            _changed.push_back(*filepath);
+        }
+    }
+}
+
+vector<string> AssetWatcher::takeChanged() {
+    vector<string> changed;
+    if (_mutex == nullptr) {
+        return changed;
+    }
+    SDL_LockMutex(_mutex);
+    changed.swap(_changed);
+    SDL_UnlockMutex(_mutex);
+    return changed;
+}
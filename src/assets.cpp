@@ -0,0 +1,310 @@
+#include <headers/assets.h>
+
+AssetManager::~AssetManager() {
+    shutdown();
+}
+
+void AssetManager::shutdown() {
+    //Must run before the renderer is destroyed, it takes every texture made with it down too
+    if (!_workers.empty()) {
+        SDL_LockMutex(_mutex);
+        _running = false;
+        SDL_CondBroadcast(_condition);
+        SDL_UnlockMutex(_mutex);
+
+        for (SDL_Thread* worker : _workers) {
+            SDL_WaitThread(worker, NULL);
+        }
+        _workers.clear();
+        SDL_DestroyCond(_condition);
+        SDL_DestroyMutex(_mutex);
+        _condition = nullptr;
+        _mutex = nullptr;
+    }
+
+    _pending.clear();
+    _decoded.clear();
+    _textures.clear();
+    _sounds.clear();
+    _fonts.clear();
+    _placeholder.reset();
+    _renderer = nullptr;
+}
+
+void AssetManager::init(SDL_Renderer* renderer, int workerCount) {
+    _renderer = renderer;
+
+    Uint32 transparent = 0;
+    _placeholder.reset(SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, 1, 1));
+    SDL_UpdateTexture(_placeholder.get(), NULL, &transparent, sizeof(transparent));
+    SDL_SetTextureBlendMode(_placeholder.get(), SDL_BLENDMODE_BLEND);
+
+    _mutex = SDL_CreateMutex();
+    _condition = SDL_CreateCond();
+    _running = true;
+
+    for (int i = 0; i < workerCount; i++) {
+        SDL_Thread* worker = SDL_CreateThread(workerThread, "AssetLoader", this);
+        if (worker == nullptr) {
+            cout << "Failed to start asset loader thread: " << SDL_GetError() << endl;
+            continue;
+        }
+        _workers.push_back(worker);
+    }
+}
+
+TextureAsset* AssetManager::getTexture(const string& filepath) {
+    auto loaded = _textures.find(filepath);
+    if (loaded != _textures.end()) {
+        return loaded->second.get();
+    }
+
+    unique_ptr<TextureAsset> asset = make_unique<TextureAsset>();
+    asset->texture = _placeholder.get();
+    TextureAsset* handle = asset.get();
+    _textures[filepath] = move(asset);
+
+    LoadJob job;
+    job.filepath = filepath;
+    job.texture = handle;
+    queue(move(job));
+    return handle;
+}
+
+TextureAsset* AssetManager::getTextureNow(const string& filepath) {
+    //For things that are built once from the texture at startup, like tile chunks
+    TextureAsset* handle = getTexture(filepath);
+    if (!handle->ready) {
+        waitUntilLoaded();
+    }
+    return handle;
+}
+
+SoundAsset* AssetManager::getSound(const string& filepath, int volume) {
+    auto loaded = _sounds.find(filepath);
+    if (loaded != _sounds.end()) {
+        return loaded->second.get();
+    }
+
+    unique_ptr<SoundAsset> asset = make_unique<SoundAsset>();
+    asset->volume = volume;
+    SoundAsset* handle = asset.get();
+    _sounds[filepath] = move(asset);
+
+    LoadJob job;
+    job.filepath = filepath;
+    job.sound = handle;
+    queue(move(job));
+    return handle;
+}
+
+FontAsset* AssetManager::getFont(const string& filepath, int size) {
+    //Fonts are small and opened straight away, they are only cached so hot reload can find them
+    string key = filepath + "@" + to_string(size);
+    auto loaded = _fonts.find(key);
+    if (loaded != _fonts.end()) {
+        return loaded->second.get();
+    }
+
+    unique_ptr<FontAsset> asset = make_unique<FontAsset>();
+    asset->filepath = filepath;
+    asset->size = size;
+    asset->font.reset(TTF_OpenFont(filepath.c_str(), size));
+    if (!asset->font) {
+        cout << "Font could not open from file path: " << filepath << " Error: " << TTF_GetError() << endl;
+    }
+    FontAsset* handle = asset.get();
+    _fonts[key] = move(asset);
+    return handle;
+}
+
+void AssetManager::queue(LoadJob&& job) {
+    if (_workers.empty()) {
+        //No loader threads (or not initialised yet), so load in place
+        decode(job);
+        finish(job);
+        return;
+    }
+
+    SDL_LockMutex(_mutex);
+    _pending.push_back(move(job));
+    SDL_CondBroadcast(_condition); //The same condition also wakes anyone in waitUntilLoaded
+    SDL_UnlockMutex(_mutex);
+}
+
+int AssetManager::workerThread(void* data) {
+    AssetManager* assets = static_cast<AssetManager*>(data);
+
+    SDL_LockMutex(assets->_mutex);
+    while (true) {
+        while (assets->_running && assets->_pending.empty()) {
+            SDL_CondWait(assets->_condition, assets->_mutex);
+        }
+        if (!assets->_running) {
+            break;
+        }
+
+        LoadJob job = move(assets->_pending.front());
+        assets->_pending.pop_front();
+        assets->_busy++;
+        SDL_UnlockMutex(assets->_mutex);
+
+        decode(job);
+
+        SDL_LockMutex(assets->_mutex);
+        assets->_decoded.push_back(move(job));
+        assets->_busy--;
+        SDL_CondBroadcast(assets->_condition);
+    }
+    SDL_UnlockMutex(assets->_mutex);
+    return 0;
+}
+
+void AssetManager::decode(LoadJob& job) {
+    //Only CPU side work happens here, nothing that touches the renderer
+    if (job.texture != nullptr) {
+        job.surface.reset(IMG_Load(job.filepath.c_str()));
+        if (!job.surface) {
+            cout << "Image could not load from file path: " << job.filepath << " Error: " << IMG_GetError() << endl;
+        }
+    }
+    else if (job.sound != nullptr) {
+        job.chunk.reset(Mix_LoadWAV(job.filepath.c_str()));
+        if (!job.chunk) {
+            cout << "Failed: " << Mix_GetError() << endl;
+        }
+    }
+    else if (job.font != nullptr) {
+        //SDL_ttf shares one FreeType library that is not thread safe, so only the file is read here
+        SDL_RWops* file = SDL_RWFromFile(job.filepath.c_str(), "rb");
+        if (file == NULL) {
+            cout << "Font could not open from file path: " << job.filepath << " Error: " << SDL_GetError() << endl;
+            return;
+        }
+        Sint64 fileSize = SDL_RWsize(file);
+        job.data.resize(fileSize > 0 ? fileSize : 0);
+        if (SDL_RWread(file, job.data.data(), 1, job.data.size()) != job.data.size()) {
+            job.data.clear();
+        }
+        SDL_RWclose(file);
+    }
+}
+
+void AssetManager::finish(LoadJob& job) {
+    //The surface or chunk goes out of scope with the job if it is not handed over
+    if (job.texture != nullptr && job.surface) {
+        TextureHandle texture(SDL_CreateTextureFromSurface(_renderer, job.surface.get()));
+        if (texture) {
+            //A hot reload swaps the texture under the handle, entities keep drawing through it
+            job.texture->loaded = move(texture);
+            job.texture->texture = job.texture->loaded.get();
+            job.texture->width = job.surface->w;
+            job.texture->height = job.surface->h;
+            job.texture->version++;
+            job.texture->ready = true;
+        }
+    }
+    else if (job.sound != nullptr && job.chunk) {
+        Mix_VolumeChunk(job.chunk.get(), job.sound->volume);
+        job.sound->chunk = move(job.chunk);
+        job.sound->ready = true;
+    }
+    else if (job.font != nullptr && !job.data.empty()) {
+        FontHandle font(TTF_OpenFontRW(SDL_RWFromConstMem(job.data.data(), job.data.size()), 1, job.font->size));
+        if (!font) {
+            cout << "Font could not open from file path: " << job.filepath << " Error: " << TTF_GetError() << endl;
+            return;
+        }
+        //The old font is closed before the bytes it reads from are freed, moving the new bytes keeps their address
+        job.font->font = move(font);
+        job.font->data = move(job.data);
+    }
+}
+
+void AssetManager::uploadPending(double budgetMs) {
+    //Without loader threads a reload is loaded in place, so there is nothing queued to upload
+    reloadChanged();
+    if (_workers.empty()) {
+        return;
+    }
+
+    //Always uploads at least one, then stops once the frame's budget is spent
+    Uint64 start = SDL_GetPerformanceCounter();
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+
+    while (true) {
+        SDL_LockMutex(_mutex);
+        if (_decoded.empty()) {
+            SDL_UnlockMutex(_mutex);
+            return;
+        }
+        LoadJob job = move(_decoded.front());
+        _decoded.pop_front();
+        SDL_UnlockMutex(_mutex);
+
+        finish(job);
+
+        if ((SDL_GetPerformanceCounter() - start) / ticksPerMs >= budgetMs) {
+            return;
+        }
+    }
+}
+
+void AssetManager::waitUntilLoaded() {
+    if (_workers.empty()) {
+        return;
+    }
+
+    SDL_LockMutex(_mutex);
+    while (!_pending.empty() || _busy > 0) {
+        SDL_CondWait(_condition, _mutex);
+    }
+    SDL_UnlockMutex(_mutex);
+
+    uploadPending(1000000);
+}
+
+void AssetManager::reloadChanged() {
+    if (!_watcher.isNative() && ++_pollTimer >= _pollInterval) {
+        _pollTimer = 0;
+        FrameVector<const string*> filepaths;
+        filepaths.reserve(_textures.size() + _sounds.size() + _fonts.size());
+        for (auto& texture : _textures) { filepaths.push_back(&texture.first); }
+        for (auto& sound : _sounds) { filepaths.push_back(&sound.first); }
+        for (auto& font : _fonts) { filepaths.push_back(&font.second->filepath); }
+        _watcher.poll(filepaths);
+    }
+
+    for (const string& filepath : _watcher.takeChanged()) {
+        reload(filepath);
+    }
+}
+
+void AssetManager::reload(const string& filepath) {
+    //Only files something has asked for are reloaded, the rest of the folder is ignored
+    auto texture = _textures.find(filepath);
+    if (texture != _textures.end()) {
+        LoadJob job;
+        job.filepath = filepath;
+        job.texture = texture->second.get();
+        queue(move(job));
+    }
+
+    auto sound = _sounds.find(filepath);
+    if (sound != _sounds.end()) {
+        LoadJob job;
+        job.filepath = filepath;
+        job.sound = sound->second.get();
+        queue(move(job));
+    }
+
+    for (auto& font : _fonts) {
+        if (font.second->filepath != filepath) {
+            continue;
+        }
+        LoadJob job;
+        job.filepath = filepath;
+        job.font = font.second.get();
+        queue(move(job));
+    }
+}
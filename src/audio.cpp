@@ -0,0 +1,146 @@
+#include <headers/audio.h>
+
+void AudioDispatcher::init(int channels) {
+    _voices.assign(Mix_AllocateChannels(channels), Voice());
+    _requests.reserve(32);
+}
+
+void AudioDispatcher::configure(SoundAsset* sound, int priority, int maxVoices) {
+    for (SoundSettings& settings : _settings) {
+        if (settings.sound == sound) {
+            settings.priority = priority;
+            settings.maxVoices = maxVoices;
+            return;
+        }
+    }
+    _settings.push_back({sound, priority, maxVoices});
+}
+
+AudioDispatcher::SoundSettings AudioDispatcher::settingsFor(SoundAsset* sound) {
+    for (SoundSettings& settings : _settings) {
+        if (settings.sound == sound) {
+            return settings;
+        }
+    }
+    return {sound, 0, _defaultMaxVoices};
+}
+
+void AudioDispatcher::play(SoundAsset* sound) {
+    if (sound == nullptr || !sound->ready) {
+        return;
+    }
+
+    //Ten coins picked up in one frame sound the same as one, so repeats are dropped
+    for (SoundSettings& request : _requests) {
+        if (request.sound == sound) {
+            return;
+        }
+    }
+    _requests.push_back(settingsFor(sound));
+}
+
+void AudioDispatcher::flush() {
+    if (_requests.empty()) {
+        return;
+    }
+
+    //Higher priorities go first so they get the free channels
+    sort(_requests.begin(), _requests.end(), [](const SoundSettings& a, const SoundSettings& b) { return a.priority > b.priority; });
+
+    Uint32 now = SDL_GetTicks();
+    for (SoundSettings& request : _requests) {
+        int channel = findChannel(request);
+        if (channel < 0) {
+            continue;
+        }
+        if (Mix_PlayChannel(channel, request.sound->chunk.get(), 0) == channel) {
+            _voices[channel] = {request.sound, request.priority, now};
+        }
+    }
+    _requests.clear();
+}
+
+int AudioDispatcher::findChannel(const SoundSettings& request) {
+    int freeChannel = -1;
+    int sameSound = 0;
+    int oldestSame = -1;
+    int victim = -1;
+
+    for (int channel = 0; channel < (int)_voices.size(); channel++) {
+        if (!Mix_Playing(channel)) {
+            _voices[channel].sound = nullptr;
+            if (freeChannel < 0) {
+                freeChannel = channel;
+            }
+            continue;
+        }
+
+        Voice& voice = _voices[channel];
+        if (voice.sound == request.sound) {
+            sameSound++;
+            if (oldestSame < 0 || voice.started < _voices[oldestSame].started) {
+                oldestSame = channel;
+            }
+        }
+        if (voice.priority < request.priority && (victim < 0 || voice.priority < _voices[victim].priority ||
+            (voice.priority == _voices[victim].priority && voice.started < _voices[victim].started))) {
+            victim = channel;
+        }
+    }
+
+    //At its own cap a sound restarts its oldest voice instead of taking another channel
+    if (sameSound >= request.maxVoices) {
+        return oldestSame;
+    }
+    if (freeChannel >= 0) {
+        return freeChannel;
+    }
+    return victim;
+}
+
+bool AudioDispatcher::playMusic(const string& filepath, int volume) {
+    //Takes the path without an extension and uses the first encoding found, compressed ones first.
+    //Mix_LoadMUS streams from the file, decoding a buffer at a time on the audio thread
+    static const char* extensions[] = {".ogg", ".opus", ".wav"};
+
+    for (const char* extension : extensions) {
+        _music.reset(Mix_LoadMUS((filepath + extension).c_str()));
+        if (_music) {
+            break;
+        }
+    }
+    if (!_music) {
+        cout << "No background music found at " << filepath << ", playing without it" << endl;
+        _musicPlaying = false;
+        return false;
+    }
+
+    Mix_VolumeMusic(volume);
+    _musicPlaying = Mix_PlayMusic(_music.get(), -1) == 0;
+    return _musicPlaying;
+}
+
+void AudioDispatcher::toggleMusic() {
+    if (!_music) {
+        return;
+    }
+    if (_musicPlaying) {
+        Mix_PauseMusic();
+    }
+    else {
+        Mix_ResumeMusic();
+    }
+    _musicPlaying = !_musicPlaying;
+}
+
+void AudioDispatcher::clear() {
+    Mix_HaltMusic();
+    _music.reset();
+    _musicPlaying = false;
+    Mix_HaltChannel(-1);
+    _requests.clear();
+    _settings.clear();
+    for (Voice& voice : _voices) {
+        voice.sound = nullptr;
+    }
+}
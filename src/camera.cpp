@@ -0,0 +1,15 @@
+#include <headers/camera.h>
+
+void Camera::init(int screenWidth, int screenHeight, int worldWidth, int worldHeight) {
+    _view = {0, 0, screenWidth, screenHeight};
+    _worldWidth = worldWidth;
+    _worldHeight = worldHeight;
+}
+
+void Camera::follow(SDL_Rect target) {
+    //Centre on the target but never show anything past the edge of the world
+    _view.x = target.x + target.w / 2 - _view.w / 2;
+    _view.y = target.y + target.h / 2 - _view.h / 2;
+    _view.x = max(0, min(_view.x, _worldWidth - _view.w));
+    _view.y = max(0, min(_view.y, _worldHeight - _view.h));
+}
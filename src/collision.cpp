@@ -0,0 +1,315 @@
+#include <headers/collision.h>
+#include <headers/entity.h>
+
+/// 
+///     GRIDBROADPHASE CLASS
+/// 
+
+void GridBroadphase::findPairs(const vector<Collider>& colliders, vector<pair<int, int>>& pairs) {
+    int count = colliders.size();
+    int maxWidth = 0;
+    int maxHeight = 0;
+    _centreX.resize(count);
+    _centreY.resize(count);
+    for (int i = 0; i < count; i++) {
+        const SDL_Rect& box = colliders[i].box;
+        _centreX[i] = box.x + box.w / 2.0f;
+        _centreY[i] = box.y + box.h / 2.0f;
+        maxWidth = max(maxWidth, box.w);
+        maxHeight = max(maxHeight, box.h);
+    }
+    _grid.build(_centreX.data(), _centreY.data(), count);
+
+    //Colliders are binned by centre, so the search reaches out by half of the largest box as well
+    for (int i = 0; i < count; i++) {
+        const Collider& collider = colliders[i];
+        if (collider.mask == 0) {
+            continue;
+        }
+
+        float reachX = (collider.box.w + maxWidth) / 2.0f;
+        float reachY = (collider.box.h + maxHeight) / 2.0f;
+        _grid.query(_centreX[i] - reachX, _centreY[i] - reachY, _centreX[i] + reachX, _centreY[i] + reachY, [&](int j) {
+            //Each pair once, and pairs the layers rule out never reach the box test
+            if (j > i && layersInteract(collider, colliders[j])) {
+                pairs.push_back({i, j});
+            }
+        });
+    }
+}
+
+/// 
+///     SWEEPANDPRUNE CLASS
+/// 
+
+void SweepAndPrune::buildSlots(const vector<Collider>& colliders) {
+    size_t size = 16;
+    while (size < colliders.size() * 2) {
+        size *= 2;
+    }
+    if (_slotHandles.size() < size) {
+        _slotHandles.resize(size);
+        _slotIndices.resize(size);
+    }
+    //Ids start at 1, so a zero handle marks an empty slot
+    fill(_slotHandles.begin(), _slotHandles.end(), 0);
+
+    for (int i = 0; i < (int)colliders.size(); i++) {
+        Uint64 key = handle(colliders[i]);
+        int slot = findSlot(key);
+        if (_slotHandles[slot] == 0) {
+            _slotHandles[slot] = key;
+            _slotIndices[slot] = i;
+        }
+    }
+}
+
+int SweepAndPrune::findSlot(Uint64 key) {
+    size_t last = _slotHandles.size() - 1;
+    size_t slot = (key * 0x9E3779B97F4A7C15ull >> 32) & last;
+    while (_slotHandles[slot] != 0 && _slotHandles[slot] != key) {
+        slot = (slot + 1) & last;
+    }
+    return slot;
+}
+
+void SweepAndPrune::findPairs(const vector<Collider>& colliders, vector<pair<int, int>>& pairs) {
+    int count = colliders.size();
+
+    //Last frame's order for everything still here, then anything new in list order
+    buildSlots(colliders);
+    _placed.assign(count, 0);
+    _order.clear();
+    for (Uint64 key : _lastOrder) {
+        int slot = findSlot(key);
+        if (_slotHandles[slot] == key && !_placed[_slotIndices[slot]]) {
+            _order.push_back(_slotIndices[slot]);
+            _placed[_slotIndices[slot]] = 1;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (!_placed[i]) {
+            _order.push_back(i);
+        }
+    }
+
+    for (int i = 1; i < count; i++) {
+        int index = _order[i];
+        int left = colliders[index].box.x;
+        int j = i - 1;
+        while (j >= 0 && colliders[_order[j]].box.x > left) {
+            _order[j + 1] = _order[j];
+            j--;
+        }
+        _order[j + 1] = index;
+    }
+
+    _lastOrder.resize(count);
+    for (int i = 0; i < count; i++) {
+        _lastOrder[i] = handle(colliders[_order[i]]);
+    }
+
+    _active.clear();
+    for (int index : _order) {
+        const Collider& collider = colliders[index];
+
+        //Anything ending before this one starts can't touch it or anything after it
+        int kept = 0;
+        for (int other : _active) {
+            if (colliders[other].box.x + colliders[other].box.w > collider.box.x) {
+                _active[kept++] = other;
+            }
+        }
+        _active.resize(kept);
+
+        for (int other : _active) {
+            if (layersInteract(collider, colliders[other])) {
+                pairs.push_back({min(index, other), max(index, other)});
+            }
+        }
+        _active.push_back(index);
+    }
+}
+
+/// 
+///     COLLISIONWORLD CLASS
+/// 
+
+CollisionWorld::~CollisionWorld() {
+    shutdown();
+}
+
+void CollisionWorld::init(int worldWidth, int worldHeight, int cellSize, int workerCount) {
+    _grid.init(worldWidth, worldHeight, cellSize);
+    if (!_threads.empty() || workerCount <= 0) {
+        _buffers.resize(max<size_t>(_buffers.size(), 1));
+        return;
+    }
+
+    _mutex = SDL_CreateMutex();
+    _start = SDL_CreateCond();
+    _done = SDL_CreateCond();
+    _running = true;
+
+    //Sized up front, the threads hold pointers into _workers
+    _workers.resize(workerCount);
+    for (int i = 0; i < workerCount; i++) {
+        _workers[i].world = this;
+        _workers[i].slice = i + 1;
+        SDL_Thread* thread = SDL_CreateThread(workerThread, "Collision", &_workers[i]);
+        if (thread == nullptr) {
+            cout << "Failed to start collision thread: " << SDL_GetError() << endl;
+            break;
+        }
+        _threads.push_back(thread);
+    }
+    _buffers.resize(_threads.size() + 1);
+}
+
+void CollisionWorld::shutdown() {
+    if (_mutex == nullptr) {
+        return;
+    }
+    SDL_LockMutex(_mutex);
+    _running = false;
+    SDL_CondBroadcast(_start);
+    SDL_UnlockMutex(_mutex);
+    for (SDL_Thread* thread : _threads) {
+        SDL_WaitThread(thread, NULL);
+    }
+    SDL_DestroyCond(_start);
+    SDL_DestroyCond(_done);
+    SDL_DestroyMutex(_mutex);
+    _threads.clear();
+    _workers.clear();
+    _buffers.resize(1);
+    _start = nullptr;
+    _done = nullptr;
+    _mutex = nullptr;
+}
+
+int CollisionWorld::workerThread(void* data) {
+    Worker* worker = (Worker*)data;
+    CollisionWorld* world = worker->world;
+    int seen = 0;
+
+    SDL_LockMutex(world->_mutex);
+    while (true) {
+        while (world->_running && world->_generation == seen) {
+            SDL_CondWait(world->_start, world->_mutex);
+        }
+        if (!world->_running) {
+            break;
+        }
+        seen = world->_generation;
+        SDL_UnlockMutex(world->_mutex);
+
+        //Colliders and pairs are only read until every slice reports back
+        world->testPairs(worker->slice, world->_buffers.size(), world->_buffers[worker->slice]);
+
+        SDL_LockMutex(world->_mutex);
+        world->_finished++;
+        SDL_CondSignal(world->_done);
+    }
+    SDL_UnlockMutex(world->_mutex);
+    return 0;
+}
+
+void CollisionWorld::clear() {
+    _colliders.clear();
+    _pairs.clear();
+    _contacts.clear();
+}
+
+void CollisionWorld::add(const Collider& collider) {
+    _colliders.push_back(collider);
+}
+
+void CollisionWorld::update() {
+    _pairs.clear();
+    _broadphase->findPairs(_colliders, _pairs);
+    narrowphase();
+    resolve();
+}
+
+void CollisionWorld::toggleBroadphase() {
+    if (_broadphase == &_grid) {
+        _broadphase = &_sweep;
+    }
+    else {
+        _broadphase = &_grid;
+    }
+    cout << "Broadphase: " << _broadphase->getName() << endl;
+}
+
+void CollisionWorld::testPairs(int slice, int slices, vector<Contact>& contacts) {
+    contacts.clear();
+    size_t begin = _pairs.size() * slice / slices;
+    size_t end = _pairs.size() * (slice + 1) / slices;
+
+    for (size_t i = begin; i < end; i++) {
+        int a = _pairs[i].first;
+        int b = _pairs[i].second;
+        if (!SDL_HasIntersection(&_colliders[a].box, &_colliders[b].box)) {
+            continue;
+        }
+
+        Contact contact;
+        contact.idA = _colliders[a].id;
+        contact.idB = _colliders[b].id;
+        contact.partA = _colliders[a].part;
+        contact.partB = _colliders[b].part;
+        contact.a = a;
+        contact.b = b;
+        if (contact.idA > contact.idB || (contact.idA == contact.idB && contact.partA > contact.partB)) {
+            swap(contact.idA, contact.idB);
+            swap(contact.partA, contact.partB);
+            swap(contact.a, contact.b);
+        }
+        contacts.push_back(contact);
+    }
+}
+
+void CollisionWorld::narrowphase() {
+    if (_buffers.size() <= 1 || (int)_pairs.size() < _parallelThreshold) {
+        _buffers.resize(max<size_t>(_buffers.size(), 1));
+        testPairs(0, 1, _buffers[0]);
+        for (size_t i = 1; i < _buffers.size(); i++) {
+            _buffers[i].clear();
+        }
+    }
+    else {
+        SDL_LockMutex(_mutex);
+        _finished = 0;
+        _generation++;
+        SDL_CondBroadcast(_start);
+        SDL_UnlockMutex(_mutex);
+
+        testPairs(0, _buffers.size(), _buffers[0]);
+
+        SDL_LockMutex(_mutex);
+        while (_finished < (int)_threads.size()) {
+            SDL_CondWait(_done, _mutex);
+        }
+        SDL_UnlockMutex(_mutex);
+    }
+
+    //Which thread found a contact, or which broadphase ordered the pairs, never changes the order they are resolved in
+    _contacts.clear();
+    for (const vector<Contact>& buffer : _buffers) {
+        _contacts.insert(_contacts.end(), buffer.begin(), buffer.end());
+    }
+    sort(_contacts.begin(), _contacts.end(), [](const Contact& x, const Contact& y) {
+        return tie(x.idA, x.idB, x.partA, x.partB) < tie(y.idA, y.idB, y.partA, y.partB);
+    });
+}
+
+void CollisionWorld::resolve() {
+    //Serial, the responses change entity state
+    for (const Contact& contact : _contacts) {
+        const Collider& a = _colliders[contact.a];
+        const Collider& b = _colliders[contact.b];
+        a.entity->collide(a, b);
+        b.entity->collide(b, a);
+    }
+}
@@ -0,0 +1,112 @@
+#include <headers/combat.h>
+#include <headers/entity.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COMBAT_SSE
+#endif
+
+void CombatResolver::resolve() {
+    _landed.clear();
+    _targets.clear();
+    _health.clear();
+    _armor.clear();
+    _incoming.clear();
+
+    //Grouped by target id, so the order hits arrive in never changes the outcome
+    stable_sort(_hits.begin(), _hits.end(), [](const Hit& a, const Hit& b) {
+        return a.target->getId() < b.target->getId();
+    });
+
+    for (const Hit& hit : _hits) {
+        Entity* target = hit.target;
+        //Targets already dead are waiting on their kill event, more hits don't kill them twice
+        if (target->isRemoved() || target->health <= 0) {
+            _landed.push_back(-1);
+            continue;
+        }
+        if (_targets.empty() || _targets.back() != target) {
+            _targets.push_back(target);
+            _health.push_back(target->health);
+            _armor.push_back(target->getArmor());
+            _incoming.push_back(0);
+        }
+        //The attacker's damage buff is already in the amount, it is the boosted damage stat
+        _incoming.back() += hit.amount;
+        _landed.push_back(_targets.size() - 1);
+    }
+
+    int targets = _targets.size();
+    size_t padded = (targets + 3) / 4 * 4;
+    _health.resize(padded, 0);
+    _armor.resize(padded, 0);
+    _incoming.resize(padded, 0);
+    applyDamage(targets);
+
+    for (size_t i = 0; i < _hits.size(); i++) {
+        if (_landed[i] == -1) {
+            continue;
+        }
+        GameEvent dealt;
+        dealt.type = DamageDealt;
+        dealt.source = _hits[i].source;
+        dealt.target = _hits[i].target;
+        dealt.position = _hits[i].position;
+        dealt.amount = mitigate(_hits[i].amount, _armor[_landed[i]]);
+        EventBus::get().publish(dealt);
+    }
+    _hits.clear();
+
+    for (int i = 0; i < targets; i++) {
+        Entity* target = _targets[i];
+        target->health = _health[i];
+        if (_health[i] <= 0) {
+            //The coin drop and removal happen when the event is dispatched
+            SDL_Rect position = target->getPosition();
+            GameEvent killed;
+            killed.type = EnemyKilled;
+            killed.target = target;
+            killed.position = {position.x + 20, position.y + position.h / 2};
+            EventBus::get().publish(killed);
+        }
+    }
+}
+
+void CombatResolver::applyDamage(int targets) {
+    //Lanes past the last target hold zeroes and are never written back
+#ifdef COMBAT_SSE
+    if (_armorScale == 0) {
+        for (int i = 0; i < targets; i += 4) {
+            __m128i health = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_health[i]));
+            __m128i incoming = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_incoming[i]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&_health[i]), _mm_sub_epi32(health, incoming));
+        }
+        return;
+    }
+
+    //Divides in floats, which truncates to the same whole damage as mitigate for anything short of 2^24
+    __m128 scale = _mm_set1_ps((float)_armorScale);
+    __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < targets; i += 4) {
+        __m128i health = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_health[i]));
+        __m128i incoming = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_incoming[i]));
+        __m128i armor = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_armor[i]));
+        armor = _mm_and_si128(armor, _mm_cmpgt_epi32(armor, zero)); //Negative armor counts as none
+        __m128 damage = _mm_div_ps(_mm_mul_ps(_mm_cvtepi32_ps(incoming), scale), _mm_add_ps(scale, _mm_cvtepi32_ps(armor)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&_health[i]), _mm_sub_epi32(health, _mm_cvttps_epi32(damage)));
+    }
+#else
+    for (int i = 0; i < targets; i++) {
+        _health[i] -= mitigate(_incoming[i], _armor[i]);
+    }
+#endif
+}
+
+void CombatResolver::clear() {
+    _hits.clear();
+    _landed.clear();
+    _targets.clear();
+    _health.clear();
+    _armor.clear();
+    _incoming.clear();
+}
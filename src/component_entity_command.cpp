@@ -7,11 +7,201 @@
 ///     ENTITYMANAGER CLASS
 /// 
 
+void EntityManager::initWorld(int screenWidth, int screenHeight, int worldWidth, int worldHeight) {
+    _camera.init(screenWidth, screenHeight, worldWidth, worldHeight);
+    _camera.follow(_player->getPosition());
+    _cullGrid.init(worldWidth, worldHeight, 128);
+    _collisions.init(worldWidth, worldHeight, 64, min(3, SDL_GetCPUCount() - 1));
+    _flowField.init(worldWidth, worldHeight, 40);
+    _steering.init(worldWidth, worldHeight);
+}
+
+bool EntityManager::loadObstacles(const string& filepath) {
+    if (!_obstacles.load(filepath)) {
+        return false;
+    }
+    //Enemies path around the walls as well as being stopped by them
+    for (const SDL_Rect& wall : _obstacles.getWalls()) {
+        _flowField.setObstacle(wall);
+    }
+    return true;
+}
+
+EntityManager::~EntityManager() {
+    //Game::cleanUp has normally cleared everything before SDL_Quit, and clearing again would call into SDL after it
+    if (_player != nullptr) {
+        clear();
+    }
+}
+
+void EntityManager::clear() {
+    sync();
+    _combat.clear();
+    for (Enemy* enemy : _enemies) { _enemyPool.release(enemy); }
+    for (PowerUp* powerUp : _powerUps) { _powerUpPools[powerUp->boostType].release(powerUp); }
+    for (Coin* coin : _coins) { _coinPool.release(coin); }
+    _enemies.clear();
+    _powerUps.clear();
+    _coins.clear();
+    _cullEntities.clear();
+
+    _enemyPool.clear();
+    _coinPool.clear();
+    _powerUpPools.clear();
+
+    delete _player;
+    _player = nullptr;
+    _flowField.shutdown();
+    _collisions.shutdown();
+    _obstacles.clear();
+}
+
+void EntityManager::removeEntity(Entity* entity) {
+    //Removing twice in a frame, say a coin touched by two collectors, only queues it once
+    if (!entity->isRemoved()) {
+        entity->markRemoved();
+        _pendingRemovals.push_back(entity);
+    }
+}
+
+void EntityManager::sync() {
+    //The one point in the frame where the lists change size, nothing is iterating them here
+    if (_pendingRemovals.empty()) {
+        return;
+    }
+
+    for (PowerUp* powerUp : _powerUps) {
+        if (powerUp->isRemoved()) { _powerUpPools[powerUp->boostType].release(powerUp); }
+    }
+    for (Enemy* enemy : _enemies) {
+        if (enemy->isRemoved()) { _enemyPool.release(enemy); }
+    }
+    for (Coin* coin : _coins) {
+        if (coin->isRemoved()) { _coinPool.release(coin); }
+    }
+
+    auto removed = [](Entity* entity) { return entity->isRemoved(); };
+    _powerUps.erase(remove_if(_powerUps.begin(), _powerUps.end(), removed), _powerUps.end());
+    _enemies.erase(remove_if(_enemies.begin(), _enemies.end(), removed), _enemies.end());
+    _coins.erase(remove_if(_coins.begin(), _coins.end(), removed), _coins.end());
+    _pendingRemovals.clear();
+}
+
+void EntityManager::initPools(SDL_Renderer* renderer, int fps, int worldWidth, int worldHeight) {
+    _enemyPool.init([=]() { return new Enemy(renderer, 0, 0, 80, 80, fps, worldWidth, worldHeight); }, _enemyPrewarm);
+    _coinPool.init([=]() { return new Coin(renderer, 0, 0, 40, 40, fps, worldWidth, worldHeight); }, _coinPrewarm);
+    for (const char* type : {"damage", "armor", "speed"}) {
+        string boostType = type;
+        _powerUpPools[boostType].init([=]() { return new PowerUp(renderer, 0, 0, 40, 40, fps, worldWidth, worldHeight, boostType); }, _powerUpPrewarm);
+    }
+}
+
+Enemy* EntityManager::createEnemy() {
+    Enemy* enemy = _enemyPool.acquire();
+    _enemies.push_back(enemy);
+    return enemy;
+}
+
+Coin* EntityManager::createCoin() {
+    Coin* coin = _coinPool.acquire();
+    _coins.push_back(coin);
+    return coin;
+}
+
+PowerUp* EntityManager::createPowerUp(const string& type) {
+    auto pool = _powerUpPools.find(type);
+    if (pool == _powerUpPools.end()) {
+        cout << "No power up pool for type: " << type << endl;
+        return nullptr;
+    }
+    PowerUp* powerUp = pool->second.acquire();
+    _powerUps.push_back(powerUp);
+    return powerUp;
+}
+
+void EntityManager::reportPools() {
+    cout << "Enemy pool: " << _enemyPool.getLive() << " live, high water " << _enemyPool.getHighWater()
+         << ", " << _enemyPool.getCreated() << " created" << endl;
+    cout << "Coin pool: " << _coinPool.getLive() << " live, high water " << _coinPool.getHighWater()
+         << ", " << _coinPool.getCreated() << " created" << endl;
+    for (auto& pool : _powerUpPools) {
+        cout << "Power up pool (" << pool.first << "): " << pool.second.getLive() << " live, high water "
+             << pool.second.getHighWater() << ", " << pool.second.getCreated() << " created" << endl;
+    }
+}
+
+void EntityManager::updateCamera() {
+    _camera.follow(_player->getPosition());
+}
+
 void EntityManager::updateEntities() {
+    SDL_Rect playerPosition = _player->getPosition();
+    _scheduler.beginFrame({playerPosition.x + playerPosition.w / 2, playerPosition.y + playerPosition.h / 2});
+
+    updateVisibility();
+    updateFlowField();
+    updateSteering();
     updatePlayer();
     updateEnemies();
     updatePowerUps();
     updateCoins();
+    updateCollisions();
+    _combat.resolve();
+
+    //Handlers may remove entities, so events go out before the lists are synced
+    EventBus::get().dispatch();
+    sync();
+}
+
+void EntityManager::updateVisibility() {
+    _cullEntities.clear();
+    _cullX.clear();
+    _cullY.clear();
+
+    for (Enemy* enemy : _enemies) { addToCulling(enemy); }
+    for (PowerUp* powerUp : _powerUps) { addToCulling(powerUp); }
+    for (Coin* coin : _coins) { addToCulling(coin); }
+
+    _cullGrid.build(_cullX.data(), _cullY.data(), _cullEntities.size());
+
+    //Entities are binned by centre, so the query is widened by a cell to catch ones hanging into the view
+    SDL_Rect view = _camera.getView();
+    float margin = _cullGrid.getCellSize();
+    _cullGrid.query(view.x - margin, view.y - margin, view.x + view.w + margin, view.y + view.h + margin, [&](int i) {
+        _cullEntities[i]->setVisible(_camera.canSee(_cullEntities[i]->getPosition()));
+    });
+}
+
+void EntityManager::addToCulling(Entity* entity) {
+    SDL_Rect position = entity->getPosition();
+    entity->setVisible(false);
+    _cullEntities.push_back(entity);
+    _cullX.push_back(position.x + position.w / 2);
+    _cullY.push_back(position.y + position.h / 2);
+}
+
+void EntityManager::updateFlowField() {
+    SDL_Rect playerPosition = _player->getPosition();
+    _flowField.setTarget(playerPosition.x + playerPosition.w / 2, playerPosition.y + playerPosition.h / 2);
+    _flowField.update();
+}
+
+void EntityManager::updateSteering() {
+    SDL_Rect target = _player->getPosition();
+
+    //Only enemies that updateEnemies will tick this frame are steered and sample the flow field.
+    //The lists were synced at the end of last frame, so the indices match the ones it uses
+    _steering.clear();
+    for (size_t i = 0; i < _enemies.size(); i++) {
+        SDL_Rect position = _enemies[i]->getPosition();
+        _steering.addAgent(position.x + position.w / 2, position.y + position.h / 2, _enemies[i]->getVelocity(), _enemies[i]->getSpeed(), isScheduled(_enemies[i], i));
+    }
+
+    _steering.update(_flowField, target.x + target.w / 2, target.y + target.h / 2);
+
+    for (size_t i = 0; i < _enemies.size(); i++) {
+        _enemies[i]->setVelocity(_steering.getVelocity(i));
+    }
 }
 
 void EntityManager::updatePlayer() {
@@ -19,20 +209,41 @@ void EntityManager::updatePlayer() {
 }
 
 void EntityManager::updateEnemies() {
-    for (Enemy* enemy : _enemies) {
-        enemy->update();
-    }
+    int index = 0;
+    forEach<Enemy>([&](Enemy* enemy) { updateScheduled(enemy, index++); });
 }
 
 void EntityManager::updatePowerUps() {
-    for (PowerUp* powerUp : _powerUps) {
-        powerUp->update();
-    }
+    int index = 0;
+    forEach<PowerUp>([&](PowerUp* powerUp) { updateScheduled(powerUp, index++); });
 }
 
 void EntityManager::updateCoins() {
-    for (Coin* coin : _coins) {
-        coin->update();
+    int index = 0;
+    forEach<Coin>([&](Coin* coin) { updateScheduled(coin, index++); });
+}
+
+void EntityManager::updateCollisions() {
+    _collisions.clear();
+    _player->addColliders(_collisions);
+    forEach<Enemy>([&](Enemy* enemy) { enemy->addColliders(_collisions); });
+    forEach<PowerUp>([&](PowerUp* powerUp) { powerUp->addColliders(_collisions); });
+    forEach<Coin>([&](Coin* coin) { coin->addColliders(_collisions); });
+    _collisions.update();
+}
+
+bool EntityManager::isScheduled(Entity* entity, int index) {
+    //Far away entities are ticked every few frames, staggered by index so the work is spread out
+    return _scheduler.shouldUpdate(index, _scheduler.getInterval(entity->getPosition(), entity->isVisible()));
+}
+
+void EntityManager::updateScheduled(Entity* entity, int index) {
+    if (isScheduled(entity, index)) {
+        entity->scheduleUpdate();
+        entity->update();
+    }
+    else {
+        entity->skipUpdate();
     }
 }
 
@@ -52,21 +263,144 @@ void EntityManager::updateEntityEvents(SDL_Event event) {
     }
 }
 
-/// 
-///     ENTITY CLASS
-/// 
+void EntityManager::saveSnapshot(Snapshot& snapshot) {
+    snapshot.write(getRandomState());
+    snapshot.write(_scheduler.getFrame());
+    snapshot.write(Entity::getNextId());
+    snapshot.write(coinsCollected);
+
+    _player->save(snapshot);
+
+    snapshot.write<int>(_enemies.size());
+    for (Enemy* enemy : _enemies) {
+        enemy->save(snapshot);
+    }
 
-void Entity::addComponent(unique_ptr<Component> component) {
-    _components.push_back(move(component));
+    snapshot.write<int>(_powerUps.size());
+    for (PowerUp* powerUp : _powerUps) {
+        snapshot.writeString(powerUp->boostType); //Needed before the powerup can be constructed on load
+        powerUp->save(snapshot);
+    }
+
+    snapshot.write<int>(_coins.size());
+    for (Coin* coin : _coins) {
+        coin->save(snapshot);
+    }
+}
+
+//A count read from a damaged file could ask for far more entities than the rest of the file can hold.
+//Every entity writes at least its rect and position, which bounds how many can be left
+static bool validCount(Snapshot& snapshot, int count, const char* list) {
+    if (count < 0 || (size_t)count > snapshot.remaining() / (2 * sizeof(SDL_Rect))) {
+        cout << "Snapshot has an invalid " << list << " count: " << count << endl;
+        return false;
+    }
+    return true;
 }
 
-void Entity::updateComponents(SDL_Renderer* renderer) {
-    for (const auto& component : _components)
-    {
-        component->update(this);
+bool EntityManager::loadSnapshot(Snapshot& snapshot, SDL_Renderer* renderer, int fps, int worldWidth, int worldHeight) {
+    //Restoring writes straight into the live entities, so the world as it is now is kept to go back to
+    //if the file turns out to be damaged part way through
+    sync();
+    Snapshot rollback;
+    saveSnapshot(rollback);
+    if (restore(snapshot)) {
+        return true;
+    }
+    cout << "Snapshot could not be restored, the world is left as it was" << endl;
+    restore(rollback);
+    return false;
+}
+
+bool EntityManager::restore(Snapshot& snapshot) {
+    sync();
+    _combat.clear();
+
+    setRandomState(snapshot.read<Uint32>());
+    _scheduler.setFrame(snapshot.read<int>());
+    Uint32 nextId = snapshot.read<Uint32>();
+    coinsCollected = snapshot.read<int>();
+
+    if (!_player->load(snapshot)) {
+        return false;
+    }
+
+    //Existing entities are reused where possible, the rest move between the lists and the pools
+    int enemyCount = snapshot.read<int>();
+    if (!validCount(snapshot, enemyCount, "enemy")) {
+        return false;
+    }
+    while ((int)_enemies.size() > enemyCount) {
+        _enemyPool.release(_enemies.back());
+        _enemies.pop_back();
+    }
+    while ((int)_enemies.size() < enemyCount) {
+        _enemies.push_back(_enemyPool.acquire());
+    }
+    for (Enemy* enemy : _enemies) {
+        if (!enemy->load(snapshot)) {
+            return false;
+        }
+    }
+
+    int powerUpCount = snapshot.read<int>();
+    if (!validCount(snapshot, powerUpCount, "power up")) {
+        return false;
+    }
+    while ((int)_powerUps.size() > powerUpCount) {
+        _powerUpPools[_powerUps.back()->boostType].release(_powerUps.back());
+        _powerUps.pop_back();
+    }
+    for (int i = 0; i < powerUpCount; i++) {
+        string boostType = snapshot.readString();
+        auto pool = _powerUpPools.find(boostType);
+        if (pool == _powerUpPools.end()) {
+            cout << "Snapshot has an unknown power up type: " << boostType << endl;
+            return false;
+        }
+        if (i == (int)_powerUps.size()) {
+            _powerUps.push_back(pool->second.acquire());
+        }
+        else if (_powerUps[i]->boostType != boostType) {
+            _powerUpPools[_powerUps[i]->boostType].release(_powerUps[i]);
+            _powerUps[i] = pool->second.acquire();
+        }
+        if (!_powerUps[i]->load(snapshot)) {
+            return false;
+        }
+    }
+
+    int coinCount = snapshot.read<int>();
+    if (!validCount(snapshot, coinCount, "coin")) {
+        return false;
+    }
+    while ((int)_coins.size() > coinCount) {
+        _coinPool.release(_coins.back());
+        _coins.pop_back();
+    }
+    while ((int)_coins.size() < coinCount) {
+        _coins.push_back(_coinPool.acquire());
     }
+    for (Coin* coin : _coins) {
+        if (!coin->load(snapshot)) {
+            return false;
+        }
+    }
+    if (snapshot.overran()) {
+        cout << "Snapshot ended before the world did" << endl;
+        return false;
+    }
+
+    //Ids order contacts, so entities created after the restore have to get the same ones as before.
+    //Set last, the entities created above took ids of their own
+    Entity::setNextId(nextId);
+    return true;
 }
 
+/// 
+///     ENTITY CLASS
+/// 
+
 void Entity::handleEvents() {
     if (currentEvent.type == SDL_KEYDOWN) {
         keys[currentEvent.key.keysym.sym] = true;
@@ -79,11 +413,15 @@ void Entity::handleEvents() {
 }
 
 void Entity::draw(SDL_Renderer* renderer) {
+    if (!_visible || _currentTexture == nullptr) {
+        return;
+    }
+    SDL_Rect screenPosition = EntityManager::get().getCamera().toScreen(_position);
     if (_currentDirection == "left") {
-        SDL_RenderCopyEx(renderer, _currentTexture, &_rect, &_position, 0, NULL, _horizontalFlip);
+        SDL_RenderCopyEx(renderer, _currentTexture->texture, &_rect, &screenPosition, 0, NULL, _horizontalFlip);
     }
     else {
-        SDL_RenderCopy(renderer, _currentTexture, &_rect, &_position); //_currentTexture, _testTexture
+        SDL_RenderCopy(renderer, _currentTexture->texture, &_rect, &screenPosition); //_currentTexture, _testTexture
     }
 }
 
@@ -103,30 +441,59 @@ bool Entity::collision(SDL_Rect otherRect) {
     return true;
 }
 
+Uint32 Entity::_nextId = 0;
+
+void Entity::addColliders(CollisionWorld& world) {
+    Collider collider;
+    collider.entity = this;
+    collider.id = _id;
+    collider.box = _position;
+    collider.layer = _layer;
+    collider.mask = _mask;
+    world.add(collider);
+}
+
 void Entity::moveUp() {
     if (_position.y > 0 - _position.h / 4 && !shooting) {
-        _position.y -= _speed;
+        step(0, -_speed * _frameStep);
     }
 }
 
 void Entity::moveDown() {
-    if (_position.y < _screenHeight - (_position.h - (_position.h / 8)) && !shooting) {
-        _position.y += _speed;
+    if (_position.y < _worldHeight - (_position.h - (_position.h / 8)) && !shooting) {
+        step(0, _speed * _frameStep);
     }
 }
 
 void Entity::moveLeft() {
     if (_position.x > 0 - _position.w / 4 && !shooting) {
-        _position.x -= _speed;
+        step(-_speed * _frameStep, 0);
     }
 }
 
 void Entity::moveRight() {
-    if (_position.x < _screenWidth - (_position.w - (_position.w / 4)) && !shooting) {
-        _position.x += _speed;
+    if (_position.x < _worldWidth - (_position.w - (_position.w / 4)) && !shooting) {
+        step(_speed * _frameStep, 0);
     }
 }
 
+void Entity::moveBy(int dx, int dy) {
+    //Same bounds as the single direction moves above
+    if (shooting) {
+        return;
+    }
+    int x = max(0 - _position.w / 4, min(_position.x + dx, _worldWidth - (_position.w - (_position.w / 4))));
+    int y = max(0 - _position.h / 4, min(_position.y + dy, _worldHeight - (_position.h - (_position.h / 8))));
+    step(x - _position.x, y - _position.y);
+}
+
+void Entity::step(int dx, int dy) {
+    //One axis at a time, so running into a wall at an angle slides along it
+    ObstacleMap& obstacles = EntityManager::get().getObstacles();
+    _position.x += obstacles.slide(_position, dx, true);
+    _position.y += obstacles.slide(_position, dy, false);
+}
+
 void Entity::powerUpBoost(PowerUp* powerUp) {
     if (powerUp->boostType == "damage") {
         _damage = powerUp->damageBoost;
@@ -140,42 +507,103 @@ void Entity::powerUpBoost(PowerUp* powerUp) {
 }
 
 void Entity::setRandomLocation() {
-    _position.x = 0 + ( rand() % ( (_screenWidth - _frameWidth) - 0 + 1 ) );
-    _position.y = 0 + ( rand() % ( (_screenHeight - _frameHeight) - 0 + 1 ) );
+    setRandomLocation({0, 0, _worldWidth, _worldHeight});
+}
+
+void Entity::setRandomLocation(SDL_Rect area) {
+    //The area is clipped to the world so spawns near an edge stay inside it
+    int left = max(0, area.x);
+    int top = max(0, area.y);
+    int right = min(_worldWidth, area.x + area.w) - _frameWidth;
+    int bottom = min(_worldHeight, area.y + area.h) - _frameHeight;
+    //A few tries to land clear of the walls, after that the entity walks out of whichever it is in
+    ObstacleMap& obstacles = EntityManager::get().getObstacles();
+    for (int attempt = 0; attempt < 8; attempt++) {
+        _position.x = randomInt(left, max(left, right));
+        _position.y = randomInt(top, max(top, bottom));
+        if (!obstacles.overlaps(_position)) {
+            break;
+        }
+    }
 }
 
 void Entity::resetTextureRect(int x, int y) {
-    _rect.x = x;
-    _rect.y = y;
+    _rect.x = _clip.frame.x + x;
+    _rect.y = _clip.frame.y + y;
+}
+
+void Entity::setClip(const SpriteClip& clip) {
+    //Switching clip keeps the playhead so running and standing stay in step, unless the new clip is shorter
+    _clip = clip;
+    _currentTexture = clip.texture;
+    _rect.y = clip.frame.y;
+    if (_rect.x < clip.frame.x || _rect.x >= clip.frame.x + clip.frames * clip.frame.w) {
+        _rect.x = clip.frame.x;
+    }
+}
+
+void Entity::save(Snapshot& snapshot) {
+    snapshot.write(_id);
+    snapshot.writeString(_currentDirection);
+    snapshot.write(_rect);
+    snapshot.write(_position);
+    snapshot.write(_speed);
+    snapshot.write(_damage);
+    snapshot.write(_armor);
+    snapshot.write(startingHealth);
+    snapshot.write(health);
+    snapshot.write(shooting);
+    snapshot.write(_velocity);
+    snapshot.write(_skippedFrames);
+
+    saveComponents(snapshot);
+}
+
+bool Entity::load(Snapshot& snapshot) {
+    _id = snapshot.read<Uint32>();
+    _currentDirection = snapshot.readString();
+    _rect = snapshot.read<SDL_Rect>();
+    _position = snapshot.read<SDL_Rect>();
+    _speed = snapshot.read<int>();
+    _damage = snapshot.read<int>();
+    _armor = snapshot.read<int>();
+    startingHealth = snapshot.read<int>();
+    health = snapshot.read<int>();
+    shooting = snapshot.read<bool>();
+    _velocity = snapshot.read<SDL_FPoint>();
+    _skippedFrames = snapshot.read<int>();
+
+    return loadComponents(snapshot);
+}
+
+void Entity::reset() {
+    //Back to how the constructor left it, for entities handed out again by a pool
+    _id = ++_nextId;
+    _removed = false;
+    _currentDirection = "down";
+    _velocity = {0, 0};
+    _frameStep = 1;
+    _skippedFrames = 0;
+    _visible = true;
+    health = startingHealth;
+    shooting = false;
+    resetComponents();
+}
+
+void Entity::setLocation(int x, int y) {
+    _position.x = x;
+    _position.y = y;
 }
 
 /// 
 ///     PLAYER CLASS
 /// 
 
-Player::Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight) {
+Player::Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight) {
     _renderer = renderer;
 
-    vector<SDL_Texture*> texture1;
-    vector<SDL_Texture*> texture2;
-    vector<SDL_Texture*> texture3 = {};
-
-    texture1.push_back(loadTexture(_renderer, "res/sprites/player/up/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/player/down/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/player/side/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/player/side/standing/standing.png"));
-
-    texture2.push_back(loadTexture(_renderer, "res/sprites/player/up/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/player/down/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/player/side/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/player/side/running/running.png"));
+    SpriteSheet* sheet = SpriteSheet::load("res/sprite_sheets/Player/player.sheet");
 
-    texture3.push_back(loadTexture(_renderer, "res/sprites/player/up/shooting/shooting.png"));
-    texture3.push_back(loadTexture(_renderer, "res/sprites/player/down/shooting/shooting.png"));
-    texture3.push_back(loadTexture(_renderer, "res/sprites/player/side/shooting/shooting.png"));
-    texture3.push_back(loadTexture(_renderer, "res/sprites/player/side/shooting/shooting.png"));
-
-    _numberOfSprites = 8;
     _animationSpeed = 5;
 
     _position.x = x;
@@ -183,18 +611,17 @@ Player::Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int
     _position.w = w;
     _position.h = h;
 
-    _screenWidth = screenWidth;
-    _screenHeight = screenHeight;
+    _worldWidth = worldWidth;
+    _worldHeight = worldHeight;
 
-    _currentTexture = texture1[0];
-    SDL_QueryTexture(texture1[0], NULL, NULL, &_textureWidth, &_textureHeight);
-    _frameWidth = _textureWidth / _numberOfSprites;
-    _frameHeight = _textureHeight;
+    _frameWidth = sheet->getFrameWidth();
+    _frameHeight = sheet->getFrameHeight();
 
     _rect.x = 0;
     _rect.y = 0;
     _rect.w = _frameWidth;
     _rect.h = _frameHeight;
+    setClip(sheet->getClip("standing", "up"));
 
     pair<int, int> _speedStats = {2, 4}; //First is base speed, Second is upgraded speed
     pair<int, int> _armorStats = {5, 15};
@@ -204,32 +631,28 @@ Player::Player(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int
     _damage = _damageStats.first;
     _armor = _armorStats.first;
 
-    centerPlayerToScreen();
+    centerPlayerToWorld();
 
-    unique_ptr<Component> moveable = make_unique<PlayerControlledMovement>(_renderer);
-    unique_ptr<Component> animation = make_unique<Animation>(_renderer, fps, _animationSpeed, 1, texture1, texture2, texture3);
-    unique_ptr<Component> buffable = make_unique<Buffable>(_renderer, _damageStats, _armorStats, _speedStats);
-    unique_ptr<Component> rangedWeapon = make_unique<RangedWeapon>(_renderer, "gun");
-    unique_ptr<Component> healthBar = make_unique<HealthBar>(_renderer);
-    unique_ptr<Component> coinCollector = make_unique<CoinCollector>(_renderer);
+    _layer = PlayerLayer;
+    _mask = PowerUpLayer | CoinLayer;
 
-    addComponent(move(moveable));
-    addComponent(move(animation));
-    addComponent(move(buffable));
-    addComponent(move(rangedWeapon));
-    addComponent(move(healthBar));
-    addComponent(move(coinCollector));
+    component<PlayerControlledMovement>() = PlayerControlledMovement(_renderer);
+    component<Animation>() = Animation(_renderer, fps, _animationSpeed, 1, sheet);
+    component<Buffable>() = Buffable(_renderer, _damageStats, _armorStats, _speedStats);
+    component<RangedWeapon>() = RangedWeapon(_renderer, "gun");
+    component<HealthBar>() = HealthBar(_renderer);
+    component<CoinCollector>() = CoinCollector(_renderer);
 }
 
 void Player::update() {
     handleEvents();
-    updateComponents(_renderer);
+    updateComponents();
     draw(_renderer);
 }
 
-void Player::centerPlayerToScreen() {
-    _position.x = (_screenWidth / 2) - _position.w / 2;
-    _position.y = (_screenHeight / 2) - _position.h / 2;
+void Player::centerPlayerToWorld() {
+    _position.x = (_worldWidth / 2) - _position.w / 2;
+    _position.y = (_worldHeight / 2) - _position.h / 2;
 }
 
 void Player::printStats() {
@@ -242,25 +665,12 @@ void Player::printStats() {
 ///     ENEMY CLASS
 ///
 
-Enemy::Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight) {
+Enemy::Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight) {
     _renderer = renderer;
     _fps = fps;
 
-    vector<SDL_Texture*> texture1;
-    vector<SDL_Texture*> texture2;
-    vector<SDL_Texture*> texture3 = {};
-
-    texture1.push_back(loadTexture(_renderer, "res/sprites/catcus/up/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/catcus/down/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/catcus/side/standing/standing.png"));
-    texture1.push_back(loadTexture(_renderer, "res/sprites/catcus/side/standing/standing.png"));
-
-    texture2.push_back(loadTexture(_renderer, "res/sprites/catcus/up/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/catcus/down/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/catcus/side/running/running.png"));
-    texture2.push_back(loadTexture(_renderer, "res/sprites/catcus/side/running/running.png"));
+    SpriteSheet* sheet = SpriteSheet::load("res/sprite_sheets/Cactus/cactus.sheet");
 
-    _numberOfSprites = 11;
     _animationSpeed = 5;
 
     _position.x = x;
@@ -268,18 +678,17 @@ Enemy::Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int sc
     _position.w = w;
     _position.h = h;
 
-    _screenWidth = screenWidth;
-    _screenHeight = screenHeight;
+    _worldWidth = worldWidth;
+    _worldHeight = worldHeight;
 
-    _currentTexture = texture1[0];
-    SDL_QueryTexture(texture1[0], NULL, NULL, &_textureWidth, &_textureHeight);
-    _frameWidth = _textureWidth / _numberOfSprites;
-    _frameHeight = _textureHeight;
+    _frameWidth = sheet->getFrameWidth();
+    _frameHeight = sheet->getFrameHeight();
 
     _rect.x = 0;
     _rect.y = 0;
     _rect.w = _frameWidth;
     _rect.h = _frameHeight;
+    setClip(sheet->getClip("standing", "up"));
 
     pair<int, int> _speedStats = {1, 2}; //First is base speed, Second is upgraded speed
     pair<int, int> _armorStats = {5, 15};
@@ -289,26 +698,18 @@ Enemy::Enemy(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int sc
     _damage = _damageStats.first;
     _armor = _armorStats.first;
 
-    unique_ptr<Component> moveable = make_unique<RandomMovement>(_renderer);
-    unique_ptr<Component> animation = make_unique<Animation>(renderer, fps, _animationSpeed, 2, texture1, texture2, texture3);
-    unique_ptr<Component> buffable = make_unique<Buffable>(renderer, _damageStats, _armorStats, _speedStats);
-    unique_ptr<Component> healthBar = make_unique<HealthBar>(_renderer);
+    _layer = EnemyLayer;
+    _mask = ProjectileLayer;
 
-    addComponent(move(moveable));
-    addComponent(move(animation));
-    addComponent(move(buffable));
-    addComponent(move(healthBar));
+    component<ChaseMovement>() = ChaseMovement(_renderer);
+    component<Animation>() = Animation(renderer, fps, _animationSpeed, 2, sheet);
+    component<Buffable>() = Buffable(renderer, _damageStats, _armorStats, _speedStats);
+    component<HealthBar>() = HealthBar(_renderer);
 }
 
 void Enemy::update() {
-    if (health <= 0) {
-        Coin* coin = new Coin(_renderer, _position.x + 20, _position.y + _position.h / 2, 40, 40, _fps, _screenWidth, _screenHeight);
-        EntityManager::get().addToCoinsList(coin);
-        EntityManager::get().removeFromEnemiesList(this);
-    }
-
     handleEvents();
-    updateComponents(_renderer);
+    updateComponents();
     draw(_renderer);
 }
 
@@ -316,21 +717,10 @@ void Enemy::update() {
 ///     POWERUP CLASS
 ///
 
-PowerUp::PowerUp(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight, string type) {
+PowerUp::PowerUp(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight, string type) {
     _renderer = renderer;
 
-    if (type == "damage") {
-        _currentTexture = loadTexture(_renderer, "res/sprites/power-up/damage/base/base.png");
-        _numberOfSprites = 6;
-    }
-    else if (type == "armor") {
-        _currentTexture = loadTexture(_renderer, "res/sprites/power-up/armor/base/base.png");
-        _numberOfSprites = 6;
-    }
-    else if (type == "speed") {
-        _currentTexture = loadTexture(_renderer, "res/sprites/power-up/speed/base/base.png");
-        _numberOfSprites = 12;
-    }
+    SpriteClip clip = SpriteSheet::load("res/sprites/power-up/power-up.sheet")->getClip(type, "base");
 
     _animationSpeed = 5;
     boostType = type;
@@ -340,28 +730,24 @@ PowerUp::PowerUp(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, in
     _position.w = w;
     _position.h = h;
 
-    _screenWidth = screenWidth;
-    _screenHeight = screenHeight;
+    _worldWidth = worldWidth;
+    _worldHeight = worldHeight;
 
-    SDL_QueryTexture(_currentTexture, NULL, NULL, &_textureWidth, &_textureHeight);
-    _frameWidth = _textureWidth / _numberOfSprites;
-    _frameHeight = _textureHeight;
+    _frameWidth = clip.frame.w;
+    _frameHeight = clip.frame.h;
 
-    _rect.x = 0;
-    _rect.y = 0;
-    _rect.w = _frameWidth;
-    _rect.h = _frameHeight;
+    _rect = clip.frame;
+    setClip(clip);
 
-    vector<SDL_Texture*> textures;
-    textures.push_back(_currentTexture);
+    _layer = PowerUpLayer;
+    _mask = PlayerLayer;
 
-    unique_ptr<Component> animation = make_unique<Animation>(_renderer, fps, _animationSpeed, 0, textures);
-    addComponent(move(animation));
+    component<Animation>() = Animation(_renderer, fps, _animationSpeed, 0);
 }
 
 void PowerUp::update() {
     handleEvents();
-    updateComponents(_renderer);
+    updateComponents();
     draw(_renderer);
 }
 
@@ -369,11 +755,10 @@ void PowerUp::update() {
 ///     COIN CLASS
 ///
 
-Coin::Coin(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int screenWidth, int screenHeight) {
+Coin::Coin(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int worldWidth, int worldHeight) {
     _renderer = renderer;
 
-    _currentTexture = loadTexture(_renderer, "res/sprites/coin/coinAnimation.png");
-    _numberOfSprites = 7;
+    SpriteClip clip = SpriteSheet::load("res/sprites/coin/coin.sheet")->getClip("spin", "base");
 
     _animationSpeed = 5;
 
@@ -382,72 +767,27 @@ Coin::Coin(SDL_Renderer* renderer, int x, int y, int w, int h, int fps, int scre
     _position.w = w;
     _position.h = h;
 
-    _screenWidth = screenWidth;
-    _screenHeight = screenHeight;
+    _worldWidth = worldWidth;
+    _worldHeight = worldHeight;
 
-    SDL_QueryTexture(_currentTexture, NULL, NULL, &_textureWidth, &_textureHeight);
-    _frameWidth = _textureWidth / _numberOfSprites;
-    _frameHeight = _textureHeight;
+    _frameWidth = clip.frame.w;
+    _frameHeight = clip.frame.h;
 
-    _rect.x = 0;
-    _rect.y = 0;
-    _rect.w = _frameWidth;
-    _rect.h = _frameHeight;
+    _rect = clip.frame;
+    setClip(clip);
 
-    vector<SDL_Texture*> textures;
-    textures.push_back(_currentTexture);
+    _layer = CoinLayer;
+    _mask = PlayerLayer;
 
-    unique_ptr<Component> animation = make_unique<Animation>(_renderer, fps, _animationSpeed, 0, textures);
-    addComponent(move(animation));
+    component<Animation>() = Animation(_renderer, fps, _animationSpeed, 0);
 }
 
 void Coin::update() {
     handleEvents();
-    updateComponents(_renderer);
+    updateComponents();
     draw(_renderer);
 }
 
-/// 
-///     PROJECTILE CLASS
-///
-
-Projectile::Projectile(SDL_Renderer* renderer, int x, int y, int w, int h, int screenWidth, int screenHeight, int target_x, int target_y, string type) {
-    _speed = 4;
-
-    _renderer = renderer;
-    _projectileType = type;
-
-    _position.x = x;
-    _position.y = y;
-    _position.w = w;
-    _position.h = h;
-
-    _angle = atan2(y - target_y, x - target_x);
-    _xVel = cos(_angle) * _speed;
-    _yVel = sin(_angle) * _speed;
-
-    if (_projectileType == "bullet") {
-        _currentTexture = loadTexture(_renderer, "res/sprites/bullet/normal_bullet.png");
-    }
-    else {
-        cout << "Invalid Projectile Type" << endl;
-    }
-
-    SDL_QueryTexture(_currentTexture, NULL, NULL, &_frameWidth, &_frameHeight);
-
-    _rect.x = 0;
-    _rect.y = 0;
-    _rect.w = _frameWidth;
-    _rect.h = _frameHeight;
-}
-
-void Projectile::update() {
-    _position.x -= _xVel;
-    _position.y -= _yVel;
-
-    SDL_RenderCopy(_renderer, _currentTexture, &_rect, &_position);
-}
-
 /// 
 ///     PLAYERCONTRLLEDMOVEMENT CLASS
 /// 
@@ -461,10 +801,10 @@ void PlayerControlledMovement::update(Entity* entity) {
 ///
 
 void RandomMovement::update(Entity* entity) {
-    moveTimer += 1;
+    moveTimer += entity->_frameStep;
 
     if (moveTimer >= 60) {
-        int randomType = 0 + ( rand() % ( 3 - 0 + 1 ) );
+        int randomType = randomInt(0, 3);
         if (randomType == 0) {
             entity->_currentDirection = "up";
         }
@@ -494,11 +834,86 @@ void RandomMovement::update(Entity* entity) {
     }
 }
 
+void RandomMovement::reset(Entity* e) {
+    moveTimer = 0;
+}
+
+void RandomMovement::save(Snapshot& snapshot) {
+    snapshot.write(moveTimer);
+}
+
+bool RandomMovement::load(Snapshot& snapshot) {
+    moveTimer = snapshot.read<int>();
+    return true;
+}
+
+/// 
+///     CHASEMOVEMENT CLASS
+///
+
+void ChaseMovement::update(Entity* entity) {
+    if (!EntityManager::get().getFlowField().isReady()) {
+        _wander.update(entity);
+        return;
+    }
+
+    //Crowd steering has already set the velocity this frame
+    _remainderX += toFixed(entity->_velocity.x) * entity->_frameStep;
+    _remainderY += toFixed(entity->_velocity.y) * entity->_frameStep;
+    int stepX = _remainderX / fixedOne;
+    int stepY = _remainderY / fixedOne;
+    _remainderX -= toFixed(stepX);
+    _remainderY -= toFixed(stepY);
+
+    entity->moveBy(stepX, stepY);
+
+    int dx = entity->_velocity.x > 0.1f ? 1 : (entity->_velocity.x < -0.1f ? -1 : 0);
+    int dy = entity->_velocity.y > 0.1f ? 1 : (entity->_velocity.y < -0.1f ? -1 : 0);
+    faceDirection(entity, dx, dy);
+}
+
+void ChaseMovement::faceDirection(Entity* entity, int dx, int dy) {
+    //Diagonal movement keeps the current facing if it still matches, to stop the sprite flickering
+    string horizontal = dx < 0 ? "left" : "right";
+    string vertical = dy < 0 ? "up" : "down";
+
+    if (dx != 0 && dy != 0) {
+        if (entity->_currentDirection != horizontal && entity->_currentDirection != vertical) {
+            entity->_currentDirection = horizontal;
+        }
+    }
+    else if (dx != 0) {
+        entity->_currentDirection = horizontal;
+    }
+    else if (dy != 0) {
+        entity->_currentDirection = vertical;
+    }
+}
+
+void ChaseMovement::reset(Entity* e) {
+    _wander.reset(e);
+    _remainderX = 0;
+    _remainderY = 0;
+}
+
+void ChaseMovement::save(Snapshot& snapshot) {
+    _wander.save(snapshot);
+    snapshot.write(_remainderX);
+    snapshot.write(_remainderY);
+}
+
+bool ChaseMovement::load(Snapshot& snapshot) {
+    _wander.load(snapshot);
+    _remainderX = snapshot.read<Fixed>();
+    _remainderY = snapshot.read<Fixed>();
+    return true;
+}
+
 /// 
 ///     ANIMATION CLASS
 /// 
 
-Animation::Animation(SDL_Renderer* renderer, int fps, int animationPerSecond, int type, vector<SDL_Texture*> texture1, vector<SDL_Texture*> texture2, vector<SDL_Texture*> texture3) {
+Animation::Animation(SDL_Renderer* renderer, int fps, int animationPerSecond, int type, SpriteSheet* sheet) {
     //Type 0 - Single sprite sheet animation with no sprites for each direction
     //Type 1 - Multiple sprite sheets for each direction/state + Animation for player control
     //Type 2 - Multiple sprite sheets for each direction/state + Animation for enemy control
@@ -509,36 +924,29 @@ Animation::Animation(SDL_Renderer* renderer, int fps, int animationPerSecond, in
     _animationPerSecond = animationPerSecond;
 
     if (type == 1 || type == 2) {
-        _texture1["up"] = texture1[0];
-        _texture1["down"] = texture1[1];
-        _texture1["right"] = texture1[2];
-        _texture1["left"] = texture1[3];
-
-        if (!texture2.empty()) {
-            _texture2["up"] = texture2[0];
-            _texture2["down"] = texture2[1];
-            _texture2["right"] = texture2[2];
-            _texture2["left"] = texture2[3];
-        }
-
-        if (!texture3.empty()) {
-            _texture3["up"] = texture3[0];
-            _texture3["down"] = texture3[1];
-            _texture3["right"] = texture3[2];
-            _texture3["left"] = texture3[3];
-        }
+        //Left uses the side clips, the entity flips them when drawing
+        _clip1["up"] = sheet->getClip("standing", "up");
+        _clip1["down"] = sheet->getClip("standing", "down");
+        _clip1["right"] = sheet->getClip("standing", "side");
+        _clip1["left"] = sheet->getClip("standing", "side");
+
+        _clip2["up"] = sheet->getClip("running", "up");
+        _clip2["down"] = sheet->getClip("running", "down");
+        _clip2["right"] = sheet->getClip("running", "side");
+        _clip2["left"] = sheet->getClip("running", "side");
+
+        _clip3["up"] = sheet->getClip("shooting", "up");
+        _clip3["down"] = sheet->getClip("shooting", "down");
+        _clip3["right"] = sheet->getClip("shooting", "side");
+        _clip3["left"] = sheet->getClip("shooting", "side");
     }
 }
 
 bool Animation::onlyMovementActivated(SDL_Keycode code, bool keysPressed[]) {
     if (keysPressed[code] == false) { return false; }
-    vector<SDL_KeyCode> codes;
-    codes = movementKeys;
 
-    codes.erase(remove(codes.begin(), codes.end(), code), codes.end());
-
-    for (auto c : codes) {
-        if (keysPressed[c] == true) {
+    for (auto c : movementKeys) {
+        if (c != code && keysPressed[c] == true) {
             return false;
         }
     }
@@ -556,7 +964,7 @@ bool Animation::movementKeysNotActivated(bool keysPressed[]) {
 
 void Animation::handlePlayerAnimation(Entity* entity) {
     if (entity->shooting) {
-        entity->_currentTexture = _texture3[entity->_currentDirection];
+        entity->setClip(_clip3[entity->_currentDirection]);
     }
     else {
         if (!movementKeysNotActivated(entity->keys)) {
@@ -570,7 +978,7 @@ void Animation::handlePlayerAnimation(Entity* entity) {
             else if (onlyMovementActivated(SDLK_a, entity->keys)) { entity->_currentDirection = "left"; }
             else if (onlyMovementActivated(SDLK_d, entity->keys)) { entity->_currentDirection = "right"; }
 
-            entity->_currentTexture = _texture2[entity->_currentDirection];
+            entity->setClip(_clip2[entity->_currentDirection]);
         }
         else {
             if (entity->lastKeyReleased == SDLK_w) { entity->_currentDirection = "up"; }
@@ -578,23 +986,23 @@ void Animation::handlePlayerAnimation(Entity* entity) {
             else if (entity->lastKeyReleased == SDLK_a) { entity->_currentDirection = "left"; }
             else if (entity->lastKeyReleased == SDLK_d) { entity->_currentDirection = "right"; }
 
-            entity->_currentTexture = _texture1[entity->_currentDirection];
+            entity->setClip(_clip1[entity->_currentDirection]);
         }
     }
 }
 
 void Animation::handleEnemyAnimation(Entity* entity) {
-    entity->_currentTexture = _texture2[entity->_currentDirection];
+    entity->setClip(_clip2[entity->_currentDirection]);
 }
 
 void Animation::update(Entity* entity) {
-    _frameTime++;
+    _frameTime += entity->_frameStep;
 
     if (_fps / _frameTime <= _animationPerSecond) {
         _frameTime = 0;
-        entity->_rect.x += entity->_frameWidth;
-        if (entity->_rect.x >= entity->_textureWidth) {
-            entity->_rect.x = 0;
+        entity->_rect.x += entity->_clip.frame.w;
+        if (entity->_rect.x >= entity->_clip.frame.x + entity->_clip.frames * entity->_clip.frame.w) {
+            entity->_rect.x = entity->_clip.frame.x;
         }
     }
 
@@ -606,6 +1014,19 @@ void Animation::update(Entity* entity) {
     }
 }
 
+void Animation::reset(Entity* e) {
+    _frameTime = 0;
+}
+
+void Animation::save(Snapshot& snapshot) {
+    snapshot.write(_frameTime);
+}
+
+bool Animation::load(Snapshot& snapshot) {
+    _frameTime = snapshot.read<int>();
+    return true;
+}
+
 ///
 ///     RANGEDWEAPON CLASS
 /// 
@@ -613,20 +1034,15 @@ void Animation::update(Entity* entity) {
 RangedWeapon::RangedWeapon(SDL_Renderer* renderer, string type) {
     _renderer = renderer;
     _type = type;
-
-    _shootSound = Mix_LoadWAV("audio/gunshot.wav");
-    if (!_shootSound) {
-        cout << "Failed: " << Mix_GetError() << endl;
-    }
-    Mix_VolumeChunk(_shootSound, 70);
+    _projectileClip = SpriteSheet::load("res/sprites/bullet/bullet.sheet")->getClip("bullet", "base");
 }
 
 void RangedWeapon::update(Entity* entity) {
-    reloadTimer++;
+    reloadTimer += entity->_frameStep;
     updateProjectile(entity);
 
     if (entity->shooting) {
-        delayTimer++;
+        delayTimer += entity->_frameStep;
         if (delayTimer >= delayThreshold) {
             entity->shooting = false;
         }
@@ -638,32 +1054,65 @@ void RangedWeapon::update(Entity* entity) {
         reloadTimer = 0;
         delayTimer = 0;
         shoot(entity);
-        Mix_PlayChannel(-1, _shootSound, 0);
+
+        GameEvent shot;
+        shot.type = ShotFired;
+        shot.source = entity;
+        shot.position = {entity->_position.x, entity->_position.y};
+        EventBus::get().publish(shot);
     }
 }
 
 void RangedWeapon::updateProjectile(Entity* entity) {
-    for (Projectile* proj : _projectiles) {
-        proj->update();
-        for (Enemy* enemy : EntityManager::get().getEnemiesList()) {
-            if (enemy->collision(proj->_position)) {
-                enemy->health -= entity->_damage;
-                destroyProjectile(proj);
-            }
+    SDL_Rect world = {0, 0, entity->_worldWidth, entity->_worldHeight};
+    Camera& camera = EntityManager::get().getCamera();
+
+    //Highest index first so removing one never moves another hit projectile
+    sort(_hits.begin(), _hits.end(), greater<int>());
+    for (int hit : _hits) {
+        _projectiles.remove(hit);
+    }
+    _hits.clear();
+
+    //Where each projectile starts the frame, so walls it would pass straight through still stop it
+    FrameVector<SDL_Rect> previous;
+    previous.reserve(_projectiles.size());
+    for (int i = 0; i < _projectiles.size(); i++) {
+        previous.push_back(_projectiles.getRect(i));
+    }
+    _projectiles.move();
+    ObstacleMap& obstacles = EntityManager::get().getObstacles();
+
+    //Backwards, so the projectile moved into a removed one's slot has already been handled
+    for (int i = _projectiles.size() - 1; i >= 0; i--) {
+        SDL_Rect position = _projectiles.getRect(i);
+        bool spent = !SDL_HasIntersection(&position, &world);
+
+        if (!spent) {
+            SDL_FPoint from = {previous[i].x + previous[i].w / 2.0f, previous[i].y + previous[i].h / 2.0f};
+            SDL_FPoint to = {position.x + position.w / 2.0f, position.y + position.h / 2.0f};
+            float fraction = 1;
+            spent = obstacles.raycast(from, to, fraction);
         }
-    }
-}
 
-void RangedWeapon::destroyProjectile(Projectile* projectile) {
-    _projectiles.erase(remove(_projectiles.begin(), _projectiles.end(), projectile), _projectiles.end());
+        if (spent) {
+            _projectiles.remove(i);
+        }
+        else if (camera.canSee(position) && _projectileClip.texture != nullptr) {
+            SDL_Rect screenPosition = camera.toScreen(position);
+            SDL_RenderCopy(_renderer, _projectileClip.texture->texture, &_projectileClip.frame, &screenPosition);
+        }
+    }
 }
 
 void RangedWeapon::shoot(Entity* entity) {
-    Projectile* projectile;
     int x, y;
     int x_bullet_pos = entity->_position.x + (entity->_frameWidth);
     int y_bullet_pos = entity->_position.y + (entity->_frameHeight);
     SDL_GetMouseState(&x, &y);
+    SDL_Point target = EntityManager::get().getCamera().toWorld(x, y);
+    x = target.x;
+    y = target.y;
 
     int x_diff = x - x_bullet_pos;
     int y_diff = y - y_bullet_pos;
@@ -696,12 +1145,86 @@ void RangedWeapon::shoot(Entity* entity) {
     }
 
     if (_type == "gun") {
-        projectile = new Projectile(_renderer, x_bullet_pos, y_bullet_pos, 7, 7, entity->_screenWidth, entity->_screenHeight, x, y, "bullet");
+        float angle = atan2(y - y_bullet_pos, x - x_bullet_pos);
+        _projectiles.add(x_bullet_pos, y_bullet_pos, cos(angle) * _projectileSpeed, sin(angle) * _projectileSpeed);
     }
     else {
         cout << "Incorrect Projectile Type" << endl;
     }
-    _projectiles.push_back(projectile);
+}
+
+void RangedWeapon::addColliders(Entity* entity, CollisionWorld& world) {
+    for (int i = 0; i < _projectiles.size(); i++) {
+        Collider collider;
+        collider.entity = entity;
+        collider.id = entity->_id;
+        collider.part = i;
+        collider.box = _projectiles.getRect(i);
+        collider.layer = ProjectileLayer;
+        collider.mask = EnemyLayer;
+        world.add(collider);
+    }
+}
+
+void RangedWeapon::collide(Entity* entity, const Collider& self, const Collider& other) {
+    if (self.part < 0 || !(other.layer & EnemyLayer)) {
+        return;
+    }
+    //A projectile only hits the first enemy it reaches
+    if (find(_hits.begin(), _hits.end(), self.part) != _hits.end()) {
+        return;
+    }
+    _hits.push_back(self.part);
+
+    Hit hit;
+    hit.source = entity;
+    hit.target = other.entity;
+    hit.amount = entity->_damage;
+    hit.position = {self.box.x, self.box.y};
+    EntityManager::get().getCombat().addHit(hit);
+}
+
+void RangedWeapon::reset(Entity* entity) {
+    reloadTimer = reloadThreshold;
+    delayTimer = 0;
+    _projectiles.clear();
+    _hits.clear();
+}
+
+void RangedWeapon::save(Snapshot& snapshot) {
+    snapshot.write(reloadTimer);
+    snapshot.write(delayTimer);
+    _projectiles.save(snapshot);
+
+    //Hits from this frame's collisions are only applied next update, so they have to survive a restore
+    snapshot.write<int>(_hits.size());
+    for (int hit : _hits) {
+        snapshot.write(hit);
+    }
+}
+
+bool RangedWeapon::load(Snapshot& snapshot) {
+    reloadTimer = snapshot.read<int>();
+    delayTimer = snapshot.read<int>();
+    if (!_projectiles.load(snapshot)) {
+        return false;
+    }
+
+    _hits.clear();
+    int count = snapshot.read<int>();
+    if (count < 0 || (size_t)count > snapshot.remaining() / sizeof(int)) {
+        cout << "Snapshot has an invalid hit count: " << count << endl;
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        int hit = snapshot.read<int>();
+        if (hit < 0 || hit >= _projectiles.size()) {
+            cout << "Snapshot has a hit on a missing projectile: " << hit << endl;
+            return false;
+        }
+        _hits.push_back(hit);
+    }
+    return true;
 }
 
 ///
@@ -715,95 +1238,73 @@ Buffable::Buffable(SDL_Renderer* renderer, pair<int, int> damage, pair<int, int>
     _armor = armor;
     _speed = speed;
 
-    _damageIndicator = loadTexture(_renderer, "res/sprites/power-up/damage/base/static.png");
-    _armorIndicator = loadTexture(_renderer, "res/sprites/power-up/armor/base/static.png");
-    _speedIndicator = loadTexture(_renderer, "res/sprites/power-up/speed/base/static.png");
-
-    _damageIPosition.w = 15;
-    _damageIPosition.h = 15;
-    _armorIPosition.w = 15;
-    _armorIPosition.h = 15;
-    _speedIPosition.w = 15;
-    _speedIPosition.h = 15;
-
-    _damageBoostSound = Mix_LoadWAV("audio/damage.wav");
-    if (!_damageBoostSound) {
-        cout << "Failed: " << Mix_GetError() << endl;
-    }
+    _damageIndicator = AssetManager::get().getTexture("res/sprites/power-up/damage/base/static.png");
+    _armorIndicator = AssetManager::get().getTexture("res/sprites/power-up/armor/base/static.png");
+    _speedIndicator = AssetManager::get().getTexture("res/sprites/power-up/speed/base/static.png");
+}
 
-    _armorBoostSound = Mix_LoadWAV("audio/armor.wav");
-    if (!_armorBoostSound) {
-        cout << "Failed: " << Mix_GetError() << endl;
+void Buffable::update(Entity* e) {
+    if (e->_visible && (_damageBoosted || _armorBoosted || _speedBoosted)) {
+        drawIndicators(e);
     }
+    handleBoosts(e);
+}
 
-    _speedBoostSound = Mix_LoadWAV("audio/speed.wav");
-    if (!_speedBoostSound) {
-        cout << "Failed: " << Mix_GetError() << endl;
+void Buffable::collide(Entity* e, const Collider& self, const Collider& other) {
+    if (self.part >= 0 || other.layer != PowerUpLayer) {
+        return;
     }
+    PowerUp* powerUp = static_cast<PowerUp*>(other.entity);
 
-    Mix_VolumeChunk(_damageBoostSound, 80);
-    Mix_VolumeChunk(_armorBoostSound, 80);
-    Mix_VolumeChunk(_speedBoostSound, 80);
-}
+    GameEvent collected;
+    collected.type = PickupCollected;
+    collected.source = e;
+    collected.target = powerUp;
+    collected.position = {powerUp->_position.x, powerUp->_position.y};
 
-void Buffable::update(Entity* e) {
-    drawIndicators(e);
-    handleBoosts(e);
-    for (PowerUp* powerUp : EntityManager::get().getPowerUpList()) {
-        if (powerUp->collision(e->_position)) {
-            if (powerUp->boostType == "damage") {
-                Mix_PlayChannel(-1, _damageBoostSound, 0);
-                _damageBoosted = true;
-                _damageBoostTimer = 300;
-                e->_damage = _damage.second;
-            }
-            else if (powerUp->boostType == "armor") {
-                Mix_PlayChannel(-1, _armorBoostSound, 0);
-                _armorBoosted = true;
-                _armorBoostTimer = 300;
-                e->_armor = _armor.second;
-            }
-            else if (powerUp->boostType == "speed") {
-                Mix_PlayChannel(-1, _speedBoostSound, 0);
-                _speedBoosted = true;
-                _speedBoostTimer = 300;
-                e->_speed = _speed.second;
-            }
-            EntityManager::get().removeFromPowerUpList(powerUp);
-        }
+    if (powerUp->boostType == "damage") {
+        _damageBoosted = true;
+        _damageBoostTimer = 300;
+        e->_damage = _damage.second;
+        collected.pickup = DamagePickup;
     }
-
-    /*for (Coin* coin : EntityManager::get().getCoinsList()) {
-        if (coin->collision(e->_position)) {
-            Mix_PlayChannel(-1, _coinCollectedSound, 0);
-            EntityManager::get().coinsCollected += 1;
-            EntityManager::get().removeFromCoinsList(coin);
-        }
-    }*/
+    else if (powerUp->boostType == "armor") {
+        _armorBoosted = true;
+        _armorBoostTimer = 300;
+        e->_armor = _armor.second;
+        collected.pickup = ArmorPickup;
+    }
+    else if (powerUp->boostType == "speed") {
+        _speedBoosted = true;
+        _speedBoostTimer = 300;
+        e->_speed = _speed.second;
+        collected.pickup = SpeedPickup;
+    }
+    //The sound and removal happen when the event is dispatched
+    EventBus::get().publish(collected);
 }
 
 void Buffable::drawIndicators(Entity* e) {
     if (_damageBoosted) {
-        _damageIPosition.x = e->_position.x + 16;
-        _damageIPosition.y = e->_position.y;
-        SDL_RenderCopy(_renderer, _damageIndicator, NULL, &_damageIPosition);
+        drawIndicator(e, _damageIndicator, _damageOffset);
     }
     if (_armorBoosted) {
-        _armorIPosition.x = e->_position.x + 31;
-        _armorIPosition.y = e->_position.y;
-        SDL_RenderCopy(_renderer, _armorIndicator, NULL, &_armorIPosition);
+        drawIndicator(e, _armorIndicator, _armorOffset);
     }
     if (_speedBoosted) {
-        _speedIPosition.x = e->_position.x + 46;
-        _speedIPosition.y = e->_position.y ;
-        SDL_RenderCopy(_renderer, _speedIndicator, NULL, &_speedIPosition);
+        drawIndicator(e, _speedIndicator, _speedOffset);
     }
+}
 
+void Buffable::drawIndicator(Entity* e, TextureAsset* indicator, const SDL_Rect& offset) {
+    SDL_Rect position = {e->_position.x + offset.x, e->_position.y + offset.y, offset.w, offset.h};
+    SDL_Rect screenPosition = EntityManager::get().getCamera().toScreen(position);
+    SDL_RenderCopy(_renderer, indicator->texture, NULL, &screenPosition);
 }
 
 void Buffable::handleBoosts(Entity* e) {
     if (_damageBoosted) {
-        _damageBoostTimer -= 1;
+        _damageBoostTimer -= e->_frameStep;
         if (_damageBoostTimer <= 0) { 
             _damageBoosted = false;
             e->_damage = _damage.first;
@@ -811,7 +1312,7 @@ void Buffable::handleBoosts(Entity* e) {
     }
 
     if (_armorBoosted) {
-        _armorBoostTimer -= 1;
+        _armorBoostTimer -= e->_frameStep;
         if (_armorBoostTimer <= 0) { 
             _armorBoosted = false;
             e->_armor = _armor.first;
@@ -819,7 +1320,7 @@ void Buffable::handleBoosts(Entity* e) {
     }
 
     if (_speedBoosted) {
-        _speedBoostTimer -= 1;
+        _speedBoostTimer -= e->_frameStep;
         if (_speedBoostTimer <= 0) { 
             _speedBoosted = false;
             e->_speed = _speed.first;
@@ -827,28 +1328,61 @@ void Buffable::handleBoosts(Entity* e) {
     }
 }
 
+void Buffable::reset(Entity* e) {
+    _damageBoosted = false;
+    _armorBoosted = false;
+    _speedBoosted = false;
+    _damageBoostTimer = 0;
+    _armorBoostTimer = 0;
+    _speedBoostTimer = 0;
+    e->_damage = _damage.first;
+    e->_armor = _armor.first;
+    e->_speed = _speed.first;
+}
+
+void Buffable::save(Snapshot& snapshot) {
+    snapshot.write(_damageBoosted);
+    snapshot.write(_armorBoosted);
+    snapshot.write(_speedBoosted);
+    snapshot.write(_damageBoostTimer);
+    snapshot.write(_armorBoostTimer);
+    snapshot.write(_speedBoostTimer);
+}
+
+bool Buffable::load(Snapshot& snapshot) {
+    _damageBoosted = snapshot.read<bool>();
+    _armorBoosted = snapshot.read<bool>();
+    _speedBoosted = snapshot.read<bool>();
+    _damageBoostTimer = snapshot.read<int>();
+    _armorBoostTimer = snapshot.read<int>();
+    _speedBoostTimer = snapshot.read<int>();
+    return true;
+}
+
 /// 
 ///     COINCOLLECTOR CLASS
 /// 
 
 CoinCollector::CoinCollector(SDL_Renderer* renderer) {
     _renderer = renderer;
-
-    _coinCollectedSound = Mix_LoadWAV("audio/coin.wav");
-    if (!_coinCollectedSound) {
-        cout << "Failed: " << Mix_GetError() << endl;
-    }
-    Mix_VolumeChunk(_coinCollectedSound, 80);
 }
 
-void CoinCollector::update(Entity* e) {
-    for (Coin* coin : EntityManager::get().getCoinsList()) {
-        if (coin->collision(e->_position)) {
-            Mix_PlayChannel(-1, _coinCollectedSound, 0);
-            EntityManager::get().coinsCollected += 1;
-            EntityManager::get().removeFromCoinsList(coin);
-        }
+void CoinCollector::update(Entity* e) {}
+
+void CoinCollector::collide(Entity* e, const Collider& self, const Collider& other) {
+    if (self.part >= 0 || other.layer != CoinLayer) {
+        return;
     }
+    Coin* coin = static_cast<Coin*>(other.entity);
+
+    GameEvent collected;
+    collected.type = PickupCollected;
+    collected.source = e;
+    collected.target = coin;
+    collected.position = {coin->_position.x, coin->_position.y};
+    collected.amount = coin->getWorth();
+    collected.pickup = CoinPickup;
+    EventBus::get().publish(collected);
 }
 
 /// 
@@ -858,12 +1392,12 @@ void CoinCollector::update(Entity* e) {
 HealthBar::HealthBar(SDL_Renderer* renderer) {
     _renderer = renderer;
 
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar1.png"));
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar2.png"));
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar3.png"));
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar4.png"));
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar5.png"));
-    _textures.push_back(loadTexture(_renderer, "res/sprites/healthbar/healthbar6.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar1.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar2.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar3.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar4.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar5.png"));
+    _textures.push_back(AssetManager::get().getTexture("res/sprites/healthbar/healthbar6.png"));
 
     _currentTexture = _textures[0];
 
@@ -872,6 +1406,22 @@ HealthBar::HealthBar(SDL_Renderer* renderer) {
 }
 
 void HealthBar::update(Entity* e) {
+    //The frame is only picked again when health has changed since it was last picked
+    if (e->health != _shownHealth || e->startingHealth != _shownStartingHealth) {
+        selectTexture(e);
+        _shownHealth = e->health;
+        _shownStartingHealth = e->startingHealth;
+        _offset.y = e->_frameHeight * 2;
+    }
+    drawBar(e);
+}
+
+void HealthBar::reset(Entity* e) {
+    _shownHealth = -1;
+    _shownStartingHealth = -1;
+}
+
+void HealthBar::selectTexture(Entity* e) {
     int threshold = e->startingHealth / 6;
 
     if (e->health >= e->startingHealth - (threshold * 1)) {
@@ -892,15 +1442,14 @@ void HealthBar::update(Entity* e) {
     else if (e->health >= e->startingHealth - (threshold * 6)) {
         _currentTexture = _textures[0];
     }
-
-    drawBar(e);
 }
 
 void HealthBar::drawBar(Entity* e) {
-    _healthBarPosition.x = e->_position.x + (23);
-    _healthBarPosition.y = e->_position.y + (e->_frameHeight * 2);
+    _healthBarPosition.x = e->_position.x + _offset.x;
+    _healthBarPosition.y = e->_position.y + _offset.y;
 
-    SDL_RenderCopy(_renderer, _currentTexture, NULL, &_healthBarPosition);
+    SDL_Rect screenPosition = EntityManager::get().getCamera().toScreen(_healthBarPosition);
+    SDL_RenderCopy(_renderer, _currentTexture->texture, NULL, &screenPosition);
 }
 
 /// 
@@ -0,0 +1,56 @@
+#include <headers/eventBus.h>
+
+void EventBus::init(int capacity) {
+    _events.resize(capacity);
+    for (vector<GameEvent>& batch : _batches) {
+        batch.reserve(capacity);
+    }
+    SDL_AtomicSet(&_count, 0);
+}
+
+void EventBus::subscribe(GameEventType type, GameEventHandler handler) {
+    _handlers[type].push_back(move(handler));
+}
+
+void EventBus::publish(const GameEvent& event) {
+    //Lock free, each publisher claims its own slot
+    int slot = SDL_AtomicAdd(&_count, 1);
+    if (slot >= (int)_events.size()) {
+        SDL_AtomicAdd(&_dropped, 1);
+        return;
+    }
+    _events[slot] = event;
+}
+
+void EventBus::dispatch() {
+    //Game thread only, once every publisher for the frame has finished
+    int count = min(SDL_AtomicGet(&_count), (int)_events.size());
+    int dropped = SDL_AtomicSet(&_dropped, 0);
+    if (dropped > 0) {
+        cout << "Event queue full, dropped " << dropped << " events" << endl;
+    }
+
+    for (int i = 0; i < count; i++) {
+        _batches[_events[i].type].push_back(_events[i]);
+    }
+    //Handlers may publish, those events wait for the next dispatch
+    SDL_AtomicSet(&_count, 0);
+
+    for (int type = 0; type < GameEventTypeCount; type++) {
+        if (_batches[type].empty()) {
+            continue;
+        }
+        for (GameEventHandler& handler : _handlers[type]) {
+            handler(_batches[type].data(), _batches[type].size());
+        }
+        _batches[type].clear();
+    }
+}
+
+void EventBus::clear() {
+    SDL_AtomicSet(&_count, 0);
+    for (int type = 0; type < GameEventTypeCount; type++) {
+        _batches[type].clear();
+        _handlers[type].clear();
+    }
+}
@@ -0,0 +1,191 @@
+#include <headers/flowField.h>
+
+static const int neighbourX[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+static const int neighbourY[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+
+FlowField::~FlowField() {
+    shutdown();
+}
+
+void FlowField::shutdown() {
+    if (_thread != nullptr) {
+        SDL_LockMutex(_mutex);
+        _running = false;
+        SDL_CondSignal(_condition);
+        SDL_UnlockMutex(_mutex);
+        SDL_WaitThread(_thread, NULL);
+        SDL_DestroyCond(_condition);
+        SDL_DestroyMutex(_mutex);
+        _thread = nullptr;
+        _condition = nullptr;
+        _mutex = nullptr;
+    }
+}
+
+void FlowField::init(int width, int height, int cellSize) {
+    _cellSize = cellSize;
+    _columns = (width + cellSize - 1) / cellSize;
+    _rows = (height + cellSize - 1) / cellSize;
+    _obstacles.assign(_columns * _rows, 0);
+    _directions.clear();
+    _targetCell = -1;
+
+    if (_thread == nullptr) {
+        _mutex = SDL_CreateMutex();
+        _condition = SDL_CreateCond();
+        _running = true;
+        _thread = SDL_CreateThread(workerThread, "FlowField", this);
+        if (_thread == nullptr) {
+            cout << "Failed to start flow field thread: " << SDL_GetError() << endl;
+        }
+    }
+}
+
+int FlowField::cellAt(int x, int y) {
+    int column = x / _cellSize;
+    int row = y / _cellSize;
+    if (x < 0 || y < 0 || column >= _columns || row >= _rows) {
+        return -1;
+    }
+    return row * _columns + column;
+}
+
+void FlowField::setObstacle(SDL_Rect area, bool blocked) {
+    int firstColumn = max(0, area.x / _cellSize);
+    int firstRow = max(0, area.y / _cellSize);
+    int lastColumn = min(_columns - 1, (area.x + area.w - 1) / _cellSize);
+    int lastRow = min(_rows - 1, (area.y + area.h - 1) / _cellSize);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            _obstacles[row * _columns + column] = blocked;
+        }
+    }
+    _targetCell = -1; //Forces a recompute on the next setTarget
+}
+
+void FlowField::setTarget(int x, int y) {
+    int cell = cellAt(x, y);
+    if (cell == -1 || cell == _targetCell || _thread == nullptr) {
+        return;
+    }
+    _targetCell = cell;
+
+    //Only the latest request matters, an older one still waiting is simply overwritten
+    SDL_LockMutex(_mutex);
+    _requestedCell = cell;
+    _requestedObstacles = _obstacles;
+    _requested = true;
+    SDL_CondSignal(_condition);
+    SDL_UnlockMutex(_mutex);
+}
+
+void FlowField::update() {
+    if (_thread == nullptr) {
+        return;
+    }
+
+    SDL_LockMutex(_mutex);
+    if (_finished) {
+        _directions.swap(_finishedDirections);
+        _finished = false;
+    }
+    SDL_UnlockMutex(_mutex);
+}
+
+bool FlowField::getDirection(int x, int y, int& dx, int& dy) {
+    int cell = cellAt(x, y);
+    if (cell == -1 || _directions.empty() || _directions[cell] == noDirection) {
+        return false;
+    }
+    dx = neighbourX[_directions[cell]];
+    dy = neighbourY[_directions[cell]];
+    return true;
+}
+
+int FlowField::workerThread(void* data) {
+    FlowField* field = static_cast<FlowField*>(data);
+    vector<Uint8> obstacles;
+    vector<Uint8> directions;
+
+    SDL_LockMutex(field->_mutex);
+    while (true) {
+        while (field->_running && !field->_requested) {
+            SDL_CondWait(field->_condition, field->_mutex);
+        }
+        if (!field->_running) {
+            break;
+        }
+
+        int targetCell = field->_requestedCell;
+        obstacles.swap(field->_requestedObstacles);
+        field->_requested = false;
+        SDL_UnlockMutex(field->_mutex);
+
+        field->compute(targetCell, obstacles, directions);
+
+        SDL_LockMutex(field->_mutex);
+        field->_finishedDirections.swap(directions);
+        field->_finished = true;
+    }
+    SDL_UnlockMutex(field->_mutex);
+    return 0;
+}
+
+void FlowField::compute(int targetCell, const vector<Uint8>& obstacles, vector<Uint8>& directions) {
+    int cellCount = _columns * _rows;
+    _distances.assign(cellCount, -1);
+    _queue.resize(cellCount);
+    directions.assign(cellCount, noDirection);
+
+    //Breadth first search outwards from the target over the four orthogonal neighbours
+    int head = 0;
+    int tail = 0;
+    _distances[targetCell] = 0;
+    _queue[tail++] = targetCell;
+
+    while (head < tail) {
+        int cell = _queue[head++];
+        int column = cell % _columns;
+        int row = cell / _columns;
+
+        for (int i = 0; i < 4; i++) {
+            int nextColumn = column + neighbourX[i];
+            int nextRow = row + neighbourY[i];
+            if (nextColumn < 0 || nextRow < 0 || nextColumn >= _columns || nextRow >= _rows) {
+                continue;
+            }
+            int next = nextRow * _columns + nextColumn;
+            if (_distances[next] == -1 && !obstacles[next]) {
+                _distances[next] = _distances[cell] + 1;
+                _queue[tail++] = next;
+            }
+        }
+    }
+
+    //Each cell then points at its closest neighbour, diagonals only when neither corner is blocked
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (_distances[cell] <= 0) {
+            continue;
+        }
+        int column = cell % _columns;
+        int row = cell / _columns;
+        int bestDistance = _distances[cell];
+
+        for (int i = 0; i < 8; i++) {
+            int nextColumn = column + neighbourX[i];
+            int nextRow = row + neighbourY[i];
+            if (nextColumn < 0 || nextRow < 0 || nextColumn >= _columns || nextRow >= _rows) {
+                continue;
+            }
+            if (i >= 4 && (obstacles[row * _columns + nextColumn] || obstacles[nextRow * _columns + column])) {
+                continue;
+            }
+            int distance = _distances[nextRow * _columns + nextColumn];
+            if (distance != -1 && distance < bestDistance) {
+                bestDistance = distance;
+                directions[cell] = i;
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#include <headers/frameArena.h>
+
+#include <new>
+#include <cstdlib>
+
+void FrameArena::init(size_t capacity) {
+    _buffer.assign(capacity, 0);
+    _used = 0;
+    _peak = 0;
+    _warned = false;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment) {
+    size_t start = (_used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes > _buffer.size()) {
+        //Still works when the arena is full, but reports it once so the capacity can be raised
+        if (!_warned) {
+            _warned = true;
+            cout << "Frame arena full (" << _buffer.size() << " bytes), falling back to the heap" << endl;
+        }
+        return ::operator new(bytes);
+    }
+
+    _used = start + bytes;
+    _peak = max(_peak, _used);
+    return _buffer.data() + start;
+}
+
+void FrameArena::deallocate(void* pointer) {
+    //Arena memory is only given back by reset
+    if (!owns(pointer)) {
+        ::operator delete(pointer);
+    }
+}
+
+void FrameArena::reset() {
+    _used = 0;
+}
+
+#ifdef ALLOCATION_DEBUG
+
+static SDL_atomic_t heapAllocations;
+
+int getHeapAllocations() {
+    return SDL_AtomicGet(&heapAllocations);
+}
+
+void* operator new(size_t bytes) {
+    SDL_AtomicAdd(&heapAllocations, 1);
+    void* pointer = malloc(bytes == 0 ? 1 : bytes);
+    if (pointer == nullptr) {
+        throw bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t bytes) {
+    return operator new(bytes);
+}
+
+void operator delete(void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t bytes) noexcept {
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t bytes) noexcept {
+    free(pointer);
+}
+
+#else
+
+int getHeapAllocations() {
+    return 0;
+}
+
+#endif
@@ -2,8 +2,12 @@
 
 Game::Game(const char* title, int x, int y, int w, int h, Uint32 flags) {
     SDL_Init(SDL_INIT_EVERYTHING);
-    Mix_Init(0);
+    if ((Mix_Init(MIX_INIT_OGG | MIX_INIT_OPUS) & MIX_INIT_OGG) == 0) {
+        cout << "Ogg music not supported: " << Mix_GetError() << endl;
+    }
+    //Sound effects are converted to this format once when loaded, so nothing is resampled while playing
     Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 1024);
+    AudioDispatcher::get().init(_mixerChannels);
 
     if (TTF_Init() == -1) {
         cout << "Failed to Initialize" << endl;
@@ -11,42 +15,59 @@ Game::Game(const char* title, int x, int y, int w, int h, Uint32 flags) {
 
     _screenWidth = w;
     _screenHeight = h;
+    _worldWidth = w * _worldScale;
+    _worldHeight = h * _worldScale;
+
+    _window.reset(SDL_CreateWindow(title, x, y, _screenWidth, _screenHeight, flags));
+    _renderer.reset(SDL_CreateRenderer(_window.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC));
 
-    _window = SDL_CreateWindow(title, x, y, _screenWidth, _screenHeight, flags);
-    _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    FrameArena::get().init(_frameArenaSize);
+    EventBus::get().init(1024);
+    AssetManager::get().init(_renderer.get());
+    AssetManager::get().watch({"res", "audio", "fonts"});
+    preloadAssets();
+    subscribeToEvents();
 
-    Player* _player = new Player(_renderer, 0, 0, 80, 80, _fps, _screenWidth, _screenHeight);
+    Player* _player = new Player(_renderer.get(), 0, 0, 80, 80, _fps, _worldWidth, _worldHeight);
     EntityManager::get().initPlayer(_player);
+    EntityManager::get().initWorld(_screenWidth, _screenHeight, _worldWidth, _worldHeight);
+    EntityManager::get().loadObstacles("res/levels/obstacles.txt");
+    EntityManager::get().initPools(_renderer.get(), _fps, _worldWidth, _worldHeight);
 
     messagePosition.x = 50;
     messagePosition.y = _screenHeight - 60;
     messagePosition.w = 30;
     messagePosition.h = 50;
-    font = loadFont("fonts/WorkSans-Black.ttf", 12);
+    font = AssetManager::get().getFont("fonts/WorkSans-Black.ttf", 12);
 
     coinPosition.x = 10;
     coinPosition.y = _screenHeight - 60;
     coinPosition.w = 30;
     coinPosition.h = 50;
-    coin = loadTexture(_renderer, "res/sprites/coin/coin.png");
+    coin = AssetManager::get().getTexture("res/sprites/coin/coin.png");
 
-    backgroundMusic = Mix_LoadMUS("audio/background.wav");
-
-    if (!backgroundMusic) {
-        std::cout << "Failed: " << Mix_GetError() << std::endl;
-    }
+    AudioDispatcher::get().playMusic("audio/background", 10);
 
-    Mix_PlayMusic(backgroundMusic, -1);
-    Mix_VolumeMusic(10);
-    musicPlaying = true;
+    _background.init(_renderer.get(), _worldWidth, _worldHeight, 40, 16);
+    _background.addTile({220, 220, 220, 255});
+    _background.addTile({216, 216, 216, 255});
+    _background.addTile({224, 222, 218, 255});
+    _background.addTile({212, 214, 216, 255});
+    _background.generate();
 
-    spawnEnemy(0);
+    _director.init(_fps, [this](const string& type, int screens) { spawnFromScript(type, screens); });
+    _director.setLiveCap(EntityManager::get().getEnemyCapacity(), []() { return (int)EntityManager::get().getEnemies().size(); });
+    _director.load("res/waves/waves.txt");
 
-    SDL_SetRenderDrawColor(_renderer, 220, 220, 220, 255);
-    SDL_RenderClear(_renderer);
-    SDL_RenderPresent(_renderer);
+    SDL_SetRenderDrawColor(_renderer.get(), 220, 220, 220, 255);
+    SDL_RenderClear(_renderer.get());
+    SDL_RenderPresent(_renderer.get());
  };
 
+Game::~Game() {
+    cleanUp();
+}
+
 void Game::run() {
     gameLoop();
 }
@@ -56,11 +77,19 @@ void Game::gameLoop() {
         _frameStart = SDL_GetTicks();
 
         handleEvents();
+        AssetManager::get().uploadPending(_uploadBudget);
         handleSpawning();
+        EntityManager::get().updateCamera();
+        _background.draw(EntityManager::get().getCamera());
+        EntityManager::get().getObstacles().draw(_renderer.get(), EntityManager::get().getCamera());
         EntityManager::get().updateEntities();
+        AudioDispatcher::get().flush();
+        captureSnapshot();
         handleUI();
         display();
         clear();
+        reportAllocations();
+        FrameArena::get().reset();
 
         _frameTime = SDL_GetTicks() - _frameStart;
 
@@ -78,6 +107,9 @@ void Game::handleEvents() {
     if (event.type == SDL_QUIT) {
         running = false;
     }
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+        _background.invalidate();
+    }
     if (event.type == SDL_KEYDOWN) {
         if (event.key.keysym.sym == SDLK_1) {
             spawnPowerUp(0);
@@ -91,15 +123,17 @@ void Game::handleEvents() {
         if (event.key.keysym.sym == SDLK_0) {
             spawnEnemy(0);
         }
+        if (event.key.keysym.sym == SDLK_F5) {
+            saveSnapshot();
+        }
+        if (event.key.keysym.sym == SDLK_F9) {
+            loadSnapshot();
+        }
         if (event.key.keysym.sym == SDLK_m) {
-            if (musicPlaying) {
-                Mix_PauseMusic();
-                musicPlaying = false;
-            }
-            else {
-                Mix_ResumeMusic();
-                musicPlaying = true;
-            }
+            AudioDispatcher::get().toggleMusic();
+        }
+        if (event.key.keysym.sym == SDLK_F2) {
+            EntityManager::get().getCollisions().toggleBroadphase();
         }
     }
 }
@@ -108,64 +142,220 @@ void Game::handleSpawning() {
     powerUpTimer++;
 
     if (powerUpTimer >= powerUpThreshold) {
-        int randomType = 0 + ( rand() % ( 2 - 0 + 1 ) );
+        int randomType = randomInt(0, 2);
         powerUpTimer = 0;
         spawnPowerUp(randomType);
     }
 
-    /*enemyTimer++;
-
-    if (enemyTimer >= enemyThreshold) {
-        //int randomType = 0 + ( rand() % ( 2 - 0 + 1 ) );
-        enemyTimer = 0;
-        spawnEnemy(0);
-    }*/
+    _director.update(_spawnBudget);
 }
 
 void Game::handleUI() {
-    string text = to_string(EntityManager::get().coinsCollected);
-    surfaceMessage = TTF_RenderText_Solid(font, text.c_str(), black); 
-    message = SDL_CreateTextureFromSurface(_renderer, surfaceMessage);
-    SDL_RenderCopy(_renderer, message, NULL, &messagePosition);
+    if (EntityManager::get().coinsCollected != shownCoins) {
+        shownCoins = EntityManager::get().coinsCollected;
+        char text[16];
+        SDL_snprintf(text, sizeof(text), "%d", shownCoins);
+        surfaceMessage.reset(TTF_RenderText_Solid(font->font.get(), text, black));
+        message.reset(SDL_CreateTextureFromSurface(_renderer.get(), surfaceMessage.get()));
+    }
+    SDL_RenderCopy(_renderer.get(), message.get(), NULL, &messagePosition);
+
+    SDL_RenderCopy(_renderer.get(), coin->texture, NULL, &coinPosition);
+}
+
+void Game::reportAllocations() {
+#ifdef ALLOCATION_DEBUG
+    //Once everything is loaded a frame should not touch the heap, spawning and pickups aside
+    if (++allocationReportTimer >= 5 * _fps) {
+        int allocations = getHeapAllocations();
+        cout << "Heap allocations in the last " << allocationReportTimer << " frames: " << allocations - allocationsAtReport
+             << ", frame arena peak: " << FrameArena::get().getPeak() << " of " << FrameArena::get().getCapacity() << " bytes" << endl;
+        allocationsAtReport = allocations;
+        allocationReportTimer = 0;
+        EntityManager::get().reportPools();
+    }
+#endif
+}
+
+void Game::captureSnapshot() {
+    _snapshot.clear();
+    _snapshot.writeHeader();
+    _snapshot.write(powerUpTimer);
+    _director.saveState(_snapshot);
+    EntityManager::get().saveSnapshot(_snapshot);
+}
+
+void Game::saveSnapshot() {
+    if (_snapshot.saveToFile(_snapshotPath)) {
+        cout << "Saved snapshot (" << _snapshot.size() << " bytes) to " << _snapshotPath << endl;
+    }
+}
+
+void Game::loadSnapshot() {
+    Snapshot snapshot;
+    if (!snapshot.loadFromFile(_snapshotPath) || !snapshot.readHeader()) {
+        return;
+    }
+
+    //The spawn state is only applied once the world has loaded, a bad file leaves both as they were
+    int timer = snapshot.read<int>();
+    SpawnDirector::State director;
+    if (_director.readState(snapshot, director) && EntityManager::get().loadSnapshot(snapshot, _renderer.get(), _fps, _worldWidth, _worldHeight)) {
+        powerUpTimer = timer;
+        _director.setState(director);
+        cout << "Loaded snapshot from " << _snapshotPath << endl;
+    }
+}
+
+void Game::preloadAssets() {
+    //Queued on the loader threads now, so the first spawn of each kind finds everything cached
+    SpriteSheet::load("res/sprite_sheets/Player/player.sheet");
+    SpriteSheet::load("res/sprite_sheets/Cactus/cactus.sheet");
+    SpriteSheet::load("res/sprites/power-up/power-up.sheet");
+    SpriteSheet::load("res/sprites/coin/coin.sheet");
+    SpriteSheet::load("res/sprites/bullet/bullet.sheet");
+
+    gunshotSound = AssetManager::get().getSound("audio/gunshot.wav", 70);
+    coinSound = AssetManager::get().getSound("audio/coin.wav", 80);
+    damageSound = AssetManager::get().getSound("audio/damage.wav", 80);
+    armorSound = AssetManager::get().getSound("audio/armor.wav", 80);
+    speedSound = AssetManager::get().getSound("audio/speed.wav", 80);
+
+    //Power ups are rare and matter most, gunfire can take over coin voices
+    AudioDispatcher::get().configure(damageSound, 2, 1);
+    AudioDispatcher::get().configure(armorSound, 2, 1);
+    AudioDispatcher::get().configure(speedSound, 2, 1);
+    AudioDispatcher::get().configure(gunshotSound, 1, 3);
+    AudioDispatcher::get().configure(coinSound, 0, 4);
+}
 
-    SDL_RenderCopy(_renderer, coin, NULL, &coinPosition);
+void Game::subscribeToEvents() {
+    EventBus::get().subscribe(EnemyKilled, [this](const GameEvent* events, int count) { onEnemiesKilled(events, count); });
+    EventBus::get().subscribe(PickupCollected, [this](const GameEvent* events, int count) { onPickupsCollected(events, count); });
+    EventBus::get().subscribe(ShotFired, [this](const GameEvent* events, int count) { onShotsFired(events, count); });
+}
+
+void Game::onEnemiesKilled(const GameEvent* events, int count) {
+    for (int i = 0; i < count; i++) {
+        if (events[i].target->isRemoved()) {
+            continue;
+        }
+        Coin* coin = EntityManager::get().createCoin();
+        coin->setLocation(events[i].position.x, events[i].position.y);
+        EntityManager::get().removeEntity(events[i].target);
+    }
+}
+
+void Game::onPickupsCollected(const GameEvent* events, int count) {
+    for (int i = 0; i < count; i++) {
+        //Two collectors touching the same pickup in one frame only get it once
+        Entity* pickup = events[i].target;
+        if (pickup->isRemoved()) {
+            continue;
+        }
+        EntityManager::get().removeEntity(pickup);
+
+        if (events[i].pickup == CoinPickup) {
+            EntityManager::get().coinsCollected += events[i].amount;
+            AudioDispatcher::get().play(coinSound);
+        }
+        else if (events[i].pickup == DamagePickup) {
+            AudioDispatcher::get().play(damageSound);
+        }
+        else if (events[i].pickup == ArmorPickup) {
+            AudioDispatcher::get().play(armorSound);
+        }
+        else if (events[i].pickup == SpeedPickup) {
+            AudioDispatcher::get().play(speedSound);
+        }
+    }
+}
+
+void Game::onShotsFired(const GameEvent* events, int count) {
+    //One gunshot per shooter per frame, a shooter firing twice in a frame would only stack the same sound
+    for (int i = 0; i < count; i++) {
+        bool heard = false;
+        for (int j = 0; j < i && !heard; j++) {
+            heard = events[j].source == events[i].source;
+        }
+        if (!heard) {
+            AudioDispatcher::get().play(gunshotSound);
+        }
+    }
 }
 
 void Game::spawnPowerUp(int type) {
-    PowerUp* powerUp;
+    PowerUp* powerUp = nullptr;
 
     if (type == 0) {
-        powerUp = new PowerUp(_renderer, 0, 0, 40, 40, _fps, _screenWidth, _screenHeight, "damage");
+        powerUp = EntityManager::get().createPowerUp("damage");
     }
     else if (type == 1) {
-        powerUp = new PowerUp(_renderer, 0, 0, 40, 40, _fps, _screenWidth, _screenHeight, "armor");
+        powerUp = EntityManager::get().createPowerUp("armor");
     }
     else if (type == 2) {
-        powerUp = new PowerUp(_renderer, 0, 0, 40, 40, _fps, _screenWidth, _screenHeight, "speed");
+        powerUp = EntityManager::get().createPowerUp("speed");
+    }
+    if (powerUp != nullptr) {
+        powerUp->setRandomLocation(spawnArea(1));
     }
-    powerUp->setRandomLocation();
-    EntityManager::get().addToPowerUpList(powerUp);
 }
 
-void Game::spawnEnemy(int type) {
-    Enemy* enemy;
+void Game::spawnEnemy(int type, int screens) {
+    Enemy* enemy = nullptr;
 
     if (type == 0) {
-        enemy = new Enemy(_renderer, 50, 50, 80, 80, _fps, _screenWidth, _screenHeight);
+        enemy = EntityManager::get().createEnemy();
     }
     
-    enemy->setRandomLocation();
-    EntityManager::get().addToEnemiesList(enemy);
+    if (enemy != nullptr) {
+        enemy->setRandomLocation(spawnArea(screens));
+    }
+}
+
+void Game::spawnFromScript(const string& type, int screens) {
+    if (type == "cactus") {
+        spawnEnemy(0, screens);
+    }
+    else {
+        cout << "Wave script has unknown enemy type: " << type << endl;
+    }
+}
+
+SDL_Rect Game::spawnArea(int screens) {
+    //A block of screens centred on the camera, so spawns land where the player can reach them
+    SDL_Rect view = EntityManager::get().getCamera().getView();
+    int w = view.w * screens;
+    int h = view.h * screens;
+    return {view.x + view.w / 2 - w / 2, view.y + view.h / 2 - h / 2, w, h};
 }
 
 void Game::display() {
-    SDL_RenderPresent(_renderer);
+    SDL_RenderPresent(_renderer.get());
 }
 void Game::clear() {
-    SDL_RenderClear(_renderer);
+    SDL_RenderClear(_renderer.get());
 }
 void Game::cleanUp() {
-    SDL_DestroyWindow(_window);
+    //Everything made with the renderer goes before it, and SDL itself goes last
+    EventBus::get().clear();
+    EntityManager::get().clear();
+    AudioDispatcher::get().clear();
+    _background.invalidate();
+    AssetManager::get().shutdown();
+    message.reset();
+    surfaceMessage.reset();
+
+    Mix_CloseAudio();
+    Mix_Quit();
+
+    _renderer.reset();
+    _window.reset();
+
+    TTF_Quit();
+    SDL_Quit();
+
+    ResourceTracker::report();
 }
 
 bool Game::collision(SDL_Rect a, SDL_Rect b) {
@@ -0,0 +1,69 @@
+#include <headers/movement.h>
+
+void MovementBuffer::add(int x, int y, float xVel, float yVel) {
+    _x.push_back(toFixed(x));
+    _y.push_back(toFixed(y));
+    _xVel.push_back(toFixed(xVel));
+    _yVel.push_back(toFixed(yVel));
+}
+
+void MovementBuffer::remove(int index) {
+    //Order does not matter, so the last one fills the gap
+    _x[index] = _x.back();
+    _y[index] = _y.back();
+    _xVel[index] = _xVel.back();
+    _yVel[index] = _yVel.back();
+    _x.pop_back();
+    _y.pop_back();
+    _xVel.pop_back();
+    _yVel.pop_back();
+}
+
+void MovementBuffer::clear() {
+    _x.clear();
+    _y.clear();
+    _xVel.clear();
+    _yVel.clear();
+}
+
+void MovementBuffer::move() {
+    Fixed* x = _x.data();
+    Fixed* y = _y.data();
+    const Fixed* xVel = _xVel.data();
+    const Fixed* yVel = _yVel.data();
+    int count = _x.size();
+
+    for (int i = 0; i < count; i++) {
+        x[i] += xVel[i];
+        y[i] += yVel[i];
+    }
+}
+
+void MovementBuffer::save(Snapshot& snapshot) {
+    snapshot.write<int>(_x.size());
+    for (size_t i = 0; i < _x.size(); i++) {
+        snapshot.write(_x[i]);
+        snapshot.write(_y[i]);
+        snapshot.write(_xVel[i]);
+        snapshot.write(_yVel[i]);
+    }
+}
+
+bool MovementBuffer::load(Snapshot& snapshot) {
+    int count = snapshot.read<int>();
+    if (count < 0 || (size_t)count > snapshot.remaining() / (4 * sizeof(Fixed))) {
+        cout << "Snapshot has an invalid projectile count: " << count << endl;
+        return false;
+    }
+    _x.resize(count);
+    _y.resize(count);
+    _xVel.resize(count);
+    _yVel.resize(count);
+    for (int i = 0; i < count; i++) {
+        _x[i] = snapshot.read<Fixed>();
+        _y[i] = snapshot.read<Fixed>();
+        _xVel[i] = snapshot.read<Fixed>();
+        _yVel[i] = snapshot.read<Fixed>();
+    }
+    return true;
+}
@@ -0,0 +1,87 @@
+#include <headers/obstacles.h>
+
+bool ObstacleMap::load(const string& filepath) {
+    ifstream file(filepath);
+    if (!file) {
+        cout << "Obstacles could not load from file path: " << filepath << endl;
+        return false;
+    }
+
+    clear();
+    string line;
+    while (getline(file, line)) {
+        istringstream words(line);
+        string keyword;
+        words >> keyword;
+
+        if (keyword == "wall") {
+            SDL_Rect wall = {0, 0, 0, 0};
+            words >> wall.x >> wall.y >> wall.w >> wall.h;
+            if (wall.w > 0 && wall.h > 0) {
+                add(wall);
+            }
+        }
+    }
+    return true;
+}
+
+void ObstacleMap::add(SDL_Rect wall) {
+    _tree.insert(wall, _walls.size());
+    _walls.push_back(wall);
+}
+
+void ObstacleMap::clear() {
+    _tree.clear();
+    _walls.clear();
+}
+
+bool ObstacleMap::overlaps(SDL_Rect box) {
+    bool found = false;
+    _tree.query(box, [&](int proxy) { found = true; });
+    return found;
+}
+
+int ObstacleMap::slide(SDL_Rect box, int distance, bool horizontal) {
+    if (distance == 0) {
+        return 0;
+    }
+
+    //Only the strip the box sweeps through can stop it
+    SDL_Rect swept = box;
+    if (horizontal) {
+        swept.w += abs(distance);
+        swept.x += min(distance, 0);
+    }
+    else {
+        swept.h += abs(distance);
+        swept.y += min(distance, 0);
+    }
+
+    int allowed = distance;
+    _tree.query(swept, [&](int proxy) {
+        SDL_Rect wall = _tree.getBox(proxy);
+        //Walls the box already overlaps are ignored, so anything spawned inside one can walk out
+        if (SDL_HasIntersection(&wall, &box)) {
+            return;
+        }
+        if (horizontal) {
+            allowed = distance > 0 ? min(allowed, wall.x - (box.x + box.w)) : max(allowed, (wall.x + wall.w) - box.x);
+        }
+        else {
+            allowed = distance > 0 ? min(allowed, wall.y - (box.y + box.h)) : max(allowed, (wall.y + wall.h) - box.y);
+        }
+    });
+    return allowed;
+}
+
+bool ObstacleMap::raycast(SDL_FPoint from, SDL_FPoint to, float& fraction) {
+    return _tree.raycast(from, to, fraction) >= 0;
+}
+
+void ObstacleMap::draw(SDL_Renderer* renderer, Camera& camera) {
+    SDL_SetRenderDrawColor(renderer, _colour.r, _colour.g, _colour.b, _colour.a);
+    _tree.query(camera.getView(), [&](int proxy) {
+        SDL_Rect screenPosition = camera.toScreen(_tree.getBox(proxy));
+        SDL_RenderFillRect(renderer, &screenPosition);
+    });
+}
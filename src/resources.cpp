@@ -0,0 +1,23 @@
+#include <headers/resources.h>
+
+SDL_atomic_t ResourceTracker::_live[ResourceKindCount];
+
+bool ResourceTracker::report() {
+#ifdef RESOURCE_DEBUG
+    static const char* names[ResourceKindCount] = {"textures", "surfaces", "chunks", "music", "fonts", "renderers", "windows", "entities"};
+    bool clean = true;
+    for (int kind = 0; kind < ResourceKindCount; kind++) {
+        int count = live((ResourceKind)kind);
+        if (count != 0) {
+            cout << "Leaked " << count << " " << names[kind] << endl;
+            clean = false;
+        }
+    }
+    if (clean) {
+        cout << "No resources leaked" << endl;
+    }
+    return clean;
+#else
+    return true;
+#endif
+}
@@ -0,0 +1,67 @@
+#include <headers/snapshot.h>
+
+void Snapshot::writeString(const string& text) {
+    write<Uint32>(text.size());
+    memcpy(reserve(text.size()), text.data(), text.size());
+}
+
+string Snapshot::readString() {
+    Uint32 length = read<Uint32>();
+    if (_readOffset + length > _size) {
+        _overran = true;
+        return "";
+    }
+    string text(_buffer.data() + _readOffset, length);
+    _readOffset += length;
+    return text;
+}
+
+void Snapshot::writeHeader() {
+    write<Uint32>(magic);
+    write<Uint32>(version);
+}
+
+bool Snapshot::readHeader() {
+    _readOffset = 0;
+    _overran = false;
+    if (read<Uint32>() != magic) {
+        cout << "Snapshot is not a valid save file" << endl;
+        return false;
+    }
+    Uint32 fileVersion = read<Uint32>();
+    if (fileVersion != version) {
+        cout << "Snapshot version " << fileVersion << " does not match expected version " << version << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::saveToFile(const char* filepath) const {
+    SDL_RWops* file = SDL_RWFromFile(filepath, "wb");
+    if (file == NULL) {
+        cout << "Snapshot could not be written to file path: " << filepath << " Error: " << SDL_GetError() << endl;
+        return false;
+    }
+
+    size_t written = SDL_RWwrite(file, _buffer.data(), 1, _size);
+    SDL_RWclose(file);
+    return written == _size;
+}
+
+bool Snapshot::loadFromFile(const char* filepath) {
+    SDL_RWops* file = SDL_RWFromFile(filepath, "rb");
+    if (file == NULL) {
+        cout << "Snapshot could not be read from file path: " << filepath << " Error: " << SDL_GetError() << endl;
+        return false;
+    }
+
+    Sint64 fileSize = SDL_RWsize(file);
+    _size = fileSize > 0 ? fileSize : 0;
+    _buffer.resize(max(_buffer.size(), _size));
+    _readOffset = 0;
+    _overran = false;
+
+    size_t read = SDL_RWread(file, _buffer.data(), 1, _size);
+    SDL_RWclose(file);
+    return read == _size;
+}
@@ -0,0 +1,29 @@
+#include <headers/spatialGrid.h>
+
+void SpatialGrid::init(int width, int height, int cellSize) {
+    _cellSize = cellSize;
+    _columns = max(1, (width + cellSize - 1) / cellSize);
+    _rows = max(1, (height + cellSize - 1) / cellSize);
+    _cellStart.assign(_columns * _rows + 1, 0);
+}
+
+void SpatialGrid::build(const float* x, const float* y, int count) {
+    _cellOf.resize(count);
+    _items.resize(count);
+    fill(_cellStart.begin(), _cellStart.end(), 0);
+
+    int cellCount = _columns * _rows;
+    for (int i = 0; i < count; i++) {
+        _cellOf[i] = rowAt(y[i]) * _columns + columnAt(x[i]);
+        _cellStart[_cellOf[i]]++;
+    }
+    for (int cell = 1; cell < cellCount; cell++) {
+        _cellStart[cell] += _cellStart[cell - 1];
+    }
+    _cellStart[cellCount] = count;
+
+    //Each cell's counter now points at its end, filling backwards leaves it at its start
+    for (int i = count - 1; i >= 0; i--) {
+        _items[--_cellStart[_cellOf[i]]] = i;
+    }
+}
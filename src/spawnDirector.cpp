@@ -0,0 +1,181 @@
+#include <headers/spawnDirector.h>
+
+void SpawnDirector::init(int fps, function<void(const string& type, int screens)> spawn) {
+    _fps = fps;
+    _spawn = move(spawn);
+}
+
+void SpawnDirector::setLiveCap(int cap, function<int()> liveCount) {
+    _liveCap = cap;
+    _liveCount = move(liveCount);
+}
+
+bool SpawnDirector::load(const string& filepath) {
+    ifstream file(filepath);
+    if (!file) {
+        cout << "Wave script could not load from file path: " << filepath << endl;
+        return false;
+    }
+
+    _waves.clear();
+    string line;
+    while (getline(file, line)) {
+        istringstream words(line);
+        string keyword;
+        words >> keyword;
+
+        if (keyword == "wave") {
+            float delay = 0;
+            words >> delay;
+            Wave wave;
+            wave.delayFrames = (int)(delay * _fps);
+            _waves.push_back(wave);
+        }
+        else if (keyword == "group" && !_waves.empty()) {
+            SpawnGroup group;
+            string curve;
+            float seconds = 0;
+            words >> group.type >> group.count >> group.screens >> seconds >> curve;
+            group.frames = max(1, (int)(seconds * _fps));
+
+            if (curve == "ease-in") {
+                group.curve = EaseInRamp;
+            }
+            else if (curve == "ease-out") {
+                group.curve = EaseOutRamp;
+            }
+            _waves.back().groups.push_back(group);
+        }
+        else if (keyword == "loop") {
+            words >> _loopPercent;
+        }
+    }
+
+    _countScale = 1;
+    _waveNumber = 0;
+    if (!_waves.empty()) {
+        startWave(0);
+    }
+    return true;
+}
+
+void SpawnDirector::startWave(int wave) {
+    _currentWave = wave;
+    _waveFrame = -_waves[wave].delayFrames;
+    _waveNumber++;
+    for (SpawnGroup& group : _waves[wave].groups) {
+        group.spawned = 0;
+    }
+}
+
+int SpawnDirector::targetCount(const SpawnGroup& group) {
+    //How many of the group should be out by now, following its ramp
+    float t = min(1.0f, (float)_waveFrame / group.frames);
+    if (group.curve == EaseInRamp) {
+        t = t * t;
+    }
+    else if (group.curve == EaseOutRamp) {
+        t = 1 - (1 - t) * (1 - t);
+    }
+    return (int)ceil(t * round(group.count * _countScale));
+}
+
+void SpawnDirector::update(double budgetMs) {
+    if (_waves.empty() || !_spawn) {
+        return;
+    }
+
+    if (++_waveFrame <= 0) {
+        return;
+    }
+
+    //Always spawns at least one when something is due, then stops once the frame's budget is spent
+    Uint64 start = SDL_GetPerformanceCounter();
+    double ticksPerMs = SDL_GetPerformanceFrequency() / 1000.0;
+    int spawnedThisFrame = 0;
+    bool finished = true;
+
+    for (SpawnGroup& group : _waves[_currentWave].groups) {
+        int target = targetCount(group);
+        while (group.spawned < target) {
+            if (spawnedThisFrame > 0 && (SDL_GetPerformanceCounter() - start) / ticksPerMs >= budgetMs) {
+                return;
+            }
+            if (_liveCap > 0 && _liveCount && _liveCount() >= _liveCap) {
+                return;
+            }
+            _spawn(group.type, group.screens);
+            group.spawned++;
+            spawnedThisFrame++;
+        }
+        if (group.spawned < round(group.count * _countScale)) {
+            finished = false;
+        }
+    }
+
+    if (!finished) {
+        return;
+    }
+
+    if (_currentWave + 1 < (int)_waves.size()) {
+        startWave(_currentWave + 1);
+    }
+    else if (_loopPercent > 0) {
+        _countScale = min(_maxCountScale, _countScale * _loopPercent / 100.0f);
+        startWave(0);
+    }
+}
+
+void SpawnDirector::saveState(Snapshot& snapshot) {
+    snapshot.write(_currentWave);
+    snapshot.write(_waveFrame);
+    snapshot.write(_waveNumber);
+    snapshot.write(_countScale);
+
+    int groupCount = _waves.empty() ? 0 : _waves[_currentWave].groups.size();
+    snapshot.write(groupCount);
+    for (int i = 0; i < groupCount; i++) {
+        snapshot.write(_waves[_currentWave].groups[i].spawned);
+    }
+}
+
+bool SpawnDirector::readState(Snapshot& snapshot, State& state) {
+    state.currentWave = snapshot.read<int>();
+    state.waveFrame = snapshot.read<int>();
+    state.waveNumber = snapshot.read<int>();
+    state.countScale = snapshot.read<float>();
+
+    //The snapshot has to have been taken with the same wave script
+    int groupCount = snapshot.read<int>();
+    int expectedGroups = 0;
+    if (!_waves.empty() && state.currentWave >= 0 && state.currentWave < (int)_waves.size()) {
+        expectedGroups = _waves[state.currentWave].groups.size();
+    }
+    else if (!_waves.empty() || state.currentWave != 0) {
+        cout << "Snapshot has an invalid wave: " << state.currentWave << endl;
+        return false;
+    }
+    if (groupCount != expectedGroups || snapshot.remaining() < (size_t)groupCount * sizeof(int)) {
+        cout << "Snapshot does not match the wave script, it has " << groupCount << " groups in wave " << state.currentWave << endl;
+        return false;
+    }
+
+    state.spawned.clear();
+    for (int i = 0; i < groupCount; i++) {
+        state.spawned.push_back(snapshot.read<int>());
+    }
+    return true;
+}
+
+void SpawnDirector::setState(const State& state) {
+    _currentWave = state.currentWave;
+    _waveFrame = state.waveFrame;
+    _waveNumber = state.waveNumber;
+    _countScale = state.countScale;
+    if (_waves.empty()) {
+        return;
+    }
+    for (int i = 0; i < (int)state.spawned.size(); i++) {
+        _waves[_currentWave].groups[i].spawned = state.spawned[i];
+    }
+}
@@ -0,0 +1,64 @@
+#include <headers/spriteSheet.h>
+
+map<string, unique_ptr<SpriteSheet>> SpriteSheet::_loaded;
+
+SpriteSheet* SpriteSheet::load(const string& filepath) {
+    //Every character of a kind shares one sheet, so only the first load touches the disk
+    auto loaded = _loaded.find(filepath);
+    if (loaded != _loaded.end()) {
+        return loaded->second.get();
+    }
+
+    unique_ptr<SpriteSheet> sheet = make_unique<SpriteSheet>();
+    if (!sheet->loadDescriptor(filepath)) {
+        cout << "Sprite sheet could not load from file path: " << filepath << endl;
+    }
+    SpriteSheet* result = sheet.get();
+    _loaded[filepath] = move(sheet);
+    return result;
+}
+
+bool SpriteSheet::loadDescriptor(const string& filepath) {
+    ifstream file(filepath);
+    if (!file) {
+        return false;
+    }
+    string directory = filepath.substr(0, filepath.find_last_of('/') + 1);
+
+    string line;
+    while (getline(file, line)) {
+        istringstream words(line);
+        string keyword;
+        words >> keyword;
+
+        if (keyword == "frame") {
+            words >> _frameWidth >> _frameHeight;
+        }
+        else if (keyword == "clip") {
+            string state, direction, image;
+            int row, frames;
+            words >> state >> direction >> row >> frames;
+            getline(words >> ws, image);
+
+            if (_textures.find(image) == _textures.end()) {
+                _textures[image] = AssetManager::get().getTexture(directory + image);
+            }
+
+            SpriteClip clip;
+            clip.texture = _textures[image];
+            clip.frame = {0, row * _frameHeight, _frameWidth, _frameHeight};
+            clip.frames = frames;
+            _clips[state + " " + direction] = clip;
+        }
+    }
+    return true;
+}
+
+SpriteClip SpriteSheet::getClip(const string& state, const string& direction) {
+    auto clip = _clips.find(state + " " + direction);
+    if (clip == _clips.end()) {
+        cout << "Sprite sheet has no clip for " << state << " " << direction << endl;
+        return SpriteClip();
+    }
+    return clip->second;
+}
@@ -0,0 +1,207 @@
+#include <headers/steering.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define STEERING_SSE
+#endif
+
+void CrowdSteering::init(int width, int height) {
+    _grid.init(width, height, (int)_neighbourRadius);
+}
+
+void CrowdSteering::addAgent(float x, float y, SDL_FPoint velocity, float maxSpeed, bool steered) {
+    if (_count == (int)_x.size()) {
+        //Grown four lanes at a time so the integrate pass never needs a scalar tail
+        size_t padded = _x.size() + 4;
+        _x.resize(padded, 0);
+        _y.resize(padded, 0);
+        _velocityX.resize(padded, 0);
+        _velocityY.resize(padded, 0);
+        _maxSpeed.resize(padded, 0);
+        _forceX.resize(padded, 0);
+        _forceY.resize(padded, 0);
+        _steered.resize(padded, false);
+    }
+    _x[_count] = x;
+    _y[_count] = y;
+    _velocityX[_count] = velocity.x;
+    _velocityY[_count] = velocity.y;
+    _maxSpeed[_count] = maxSpeed;
+    _steered[_count] = steered;
+    _count++;
+}
+
+void CrowdSteering::update(FlowField& field, float targetX, float targetY) {
+    _grid.build(_x.data(), _y.data(), _count);
+    sortByCell();
+
+    for (int i = 0; i < _count; i++) {
+        if (!_steered[i]) {
+            _forceX[i] = 0;
+            _forceY[i] = 0;
+            continue;
+        }
+
+        //Seek along the flow field, or straight at the target once inside its cell
+        int dx = 0;
+        int dy = 0;
+        float desiredX;
+        float desiredY;
+        if (field.getDirection((int)_x[i], (int)_y[i], dx, dy)) {
+            desiredX = (float)dx;
+            desiredY = (float)dy;
+        }
+        else {
+            desiredX = targetX - _x[i];
+            desiredY = targetY - _y[i];
+        }
+        float length = sqrt(desiredX * desiredX + desiredY * desiredY);
+        if (length > 0) {
+            desiredX = desiredX / length * _maxSpeed[i];
+            desiredY = desiredY / length * _maxSpeed[i];
+        }
+
+        float separationX = 0;
+        float separationY = 0;
+        float alignmentX = 0;
+        float alignmentY = 0;
+        float count = 0;
+        float x = _x[i];
+        float y = _y[i];
+        _grid.queryRuns(x - _neighbourRadius, y - _neighbourRadius, x + _neighbourRadius, y + _neighbourRadius, [&](int begin, int end) {
+            accumulateRun(i, begin, end, separationX, separationY, alignmentX, alignmentY, count);
+        });
+
+        _forceX[i] = (desiredX - _velocityX[i]) * _seekWeight + separationX * _separationWeight;
+        _forceY[i] = (desiredY - _velocityY[i]) * _seekWeight + separationY * _separationWeight;
+        if (count > 0) {
+            _forceX[i] += (alignmentX / count - _velocityX[i]) * _alignmentWeight;
+            _forceY[i] += (alignmentY / count - _velocityY[i]) * _alignmentWeight;
+        }
+    }
+
+    integrate();
+}
+
+void CrowdSteering::sortByCell() {
+    //One gather per frame, after this every neighbour loop reads the arrays in order
+    size_t padded = _count + 4;
+    if (_cellX.size() < padded) {
+        _cellX.resize(padded, 0);
+        _cellY.resize(padded, 0);
+        _cellVelocityX.resize(padded, 0);
+        _cellVelocityY.resize(padded, 0);
+        _cellAgent.resize(padded, -1);
+    }
+
+    const vector<int>& items = _grid.getItems();
+    for (int k = 0; k < _count; k++) {
+        int agent = items[k];
+        _cellX[k] = _x[agent];
+        _cellY[k] = _y[agent];
+        _cellVelocityX[k] = _velocityX[agent];
+        _cellVelocityY[k] = _velocityY[agent];
+        _cellAgent[k] = (float)agent;
+    }
+}
+
+void CrowdSteering::accumulateRun(int agent, int begin, int end, float& separationX, float& separationY, float& alignmentX, float& alignmentY, float& count) {
+    float radiusSquared = _neighbourRadius * _neighbourRadius;
+
+#ifdef STEERING_SSE
+    __m128 x = _mm_set1_ps(_x[agent]);
+    __m128 y = _mm_set1_ps(_y[agent]);
+    __m128 self = _mm_set1_ps((float)agent);
+    __m128 last = _mm_set1_ps((float)end);
+    __m128 radius = _mm_set1_ps(radiusSquared);
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 minusHalf = _mm_set1_ps(-0.5f);
+    __m128 sumSeparationX = _mm_setzero_ps();
+    __m128 sumSeparationY = _mm_setzero_ps();
+    __m128 sumAlignmentX = _mm_setzero_ps();
+    __m128 sumAlignmentY = _mm_setzero_ps();
+    __m128 sumCount = _mm_setzero_ps();
+
+    for (int k = begin; k < end; k += 4) {
+        __m128 other = _mm_loadu_ps(&_cellAgent[k]);
+        __m128 dx = _mm_sub_ps(x, _mm_loadu_ps(&_cellX[k]));
+        __m128 dy = _mm_sub_ps(y, _mm_loadu_ps(&_cellY[k]));
+
+        //Lanes past the run and the agent itself are masked out
+        __m128 lane = _mm_setr_ps((float)k, (float)(k + 1), (float)(k + 2), (float)(k + 3));
+        __m128 valid = _mm_andnot_ps(_mm_cmpeq_ps(other, self), _mm_cmplt_ps(lane, last));
+
+        //Agents on the same spot are nudged apart in a consistent direction
+        __m128 sameSpot = _mm_and_ps(valid, _mm_and_ps(_mm_cmpeq_ps(dx, zero), _mm_cmpeq_ps(dy, zero)));
+        __m128 before = _mm_cmplt_ps(other, self);
+        __m128 nudge = _mm_or_ps(_mm_and_ps(before, half), _mm_andnot_ps(before, minusHalf));
+        dx = _mm_add_ps(dx, _mm_and_ps(sameSpot, nudge));
+
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 inRange = _mm_and_ps(valid, _mm_cmplt_ps(distanceSquared, radius));
+        __m128 inverse = _mm_and_ps(inRange, _mm_div_ps(one, _mm_max_ps(distanceSquared, one)));
+
+        sumSeparationX = _mm_add_ps(sumSeparationX, _mm_mul_ps(dx, inverse));
+        sumSeparationY = _mm_add_ps(sumSeparationY, _mm_mul_ps(dy, inverse));
+        sumAlignmentX = _mm_add_ps(sumAlignmentX, _mm_and_ps(inRange, _mm_loadu_ps(&_cellVelocityX[k])));
+        sumAlignmentY = _mm_add_ps(sumAlignmentY, _mm_and_ps(inRange, _mm_loadu_ps(&_cellVelocityY[k])));
+        sumCount = _mm_add_ps(sumCount, _mm_and_ps(inRange, one));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, sumSeparationX); separationX += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm_storeu_ps(lanes, sumSeparationY); separationY += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm_storeu_ps(lanes, sumAlignmentX); alignmentX += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm_storeu_ps(lanes, sumAlignmentY); alignmentY += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm_storeu_ps(lanes, sumCount); count += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+    for (int k = begin; k < end; k++) {
+        int other = (int)_cellAgent[k];
+        if (other == agent) {
+            continue;
+        }
+        float dx = _x[agent] - _cellX[k];
+        float dy = _y[agent] - _cellY[k];
+        if (dx == 0 && dy == 0) {
+            //Agents on the same spot are nudged apart in a consistent direction
+            dx = other < agent ? 0.5f : -0.5f;
+        }
+        float distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared < radiusSquared) {
+            float inverse = 1.0f / max(distanceSquared, 1.0f);
+            separationX += dx * inverse;
+            separationY += dy * inverse;
+            alignmentX += _cellVelocityX[k];
+            alignmentY += _cellVelocityY[k];
+            count += 1;
+        }
+    }
+#endif
+}
+
+void CrowdSteering::integrate() {
+    //Apply each force then clamp the speed, lanes past the last agent are scratch and never read back
+#ifdef STEERING_SSE
+    __m128 tiny = _mm_set1_ps(0.0001f);
+    __m128 one = _mm_set1_ps(1.0f);
+    for (int i = 0; i < _count; i += 4) {
+        __m128 velocityX = _mm_add_ps(_mm_loadu_ps(&_velocityX[i]), _mm_loadu_ps(&_forceX[i]));
+        __m128 velocityY = _mm_add_ps(_mm_loadu_ps(&_velocityY[i]), _mm_loadu_ps(&_forceY[i]));
+        __m128 speed = _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)), tiny));
+        __m128 scale = _mm_min_ps(one, _mm_div_ps(_mm_loadu_ps(&_maxSpeed[i]), speed));
+        _mm_storeu_ps(&_velocityX[i], _mm_mul_ps(velocityX, scale));
+        _mm_storeu_ps(&_velocityY[i], _mm_mul_ps(velocityY, scale));
+    }
+#else
+    for (int i = 0; i < _count; i++) {
+        float velocityX = _velocityX[i] + _forceX[i];
+        float velocityY = _velocityY[i] + _forceY[i];
+        float speed = sqrt(max(velocityX * velocityX + velocityY * velocityY, 0.0001f));
+        float scale = min(1.0f, _maxSpeed[i] / speed);
+        _velocityX[i] = velocityX * scale;
+        _velocityY[i] = velocityY * scale;
+    }
+#endif
+}
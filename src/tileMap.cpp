@@ -0,0 +1,152 @@
+#include <headers/tileMap.h>
+
+TileMap::~TileMap() {
+    invalidate();
+}
+
+void TileMap::init(SDL_Renderer* renderer, int worldWidth, int worldHeight, int tileSize, int chunkTiles) {
+    _renderer = renderer;
+    _tileSize = tileSize;
+    _chunkTiles = chunkTiles;
+    _chunkSize = tileSize * chunkTiles;
+    _columns = (worldWidth + tileSize - 1) / tileSize;
+    _rows = (worldHeight + tileSize - 1) / tileSize;
+    _chunkColumns = (_columns + chunkTiles - 1) / chunkTiles;
+    _chunkRows = (_rows + chunkTiles - 1) / chunkTiles;
+    invalidate();
+}
+
+void TileMap::addTile(const char* filepath) {
+    //Chunks are drawn from the pixels once, so the tile has to be loaded before the first chunk
+    //The asset is kept rather than its texture, a hot reload replaces the texture under it
+    TextureAsset* texture = AssetManager::get().getTextureNow(filepath);
+    _tileTextures.push_back(texture);
+    _tileVersions.push_back(texture->version);
+    _tileColours.push_back({220, 220, 220, 255});
+}
+
+void TileMap::addTile(SDL_Color colour) {
+    _tileTextures.push_back(nullptr);
+    _tileVersions.push_back(0);
+    _tileColours.push_back(colour);
+}
+
+void TileMap::generate() {
+    //Hashed from the tile position rather than drawn from the game's random generator,
+    //so the map is the same every run and loading a snapshot does not change it
+    _tiles.resize(_columns * _rows);
+    for (int row = 0; row < _rows; row++) {
+        for (int column = 0; column < _columns; column++) {
+            Uint32 hash = (Uint32)column * 73856093u ^ (Uint32)row * 19349663u;
+            hash ^= hash >> 13;
+            hash *= 0x5bd1e995u;
+            hash ^= hash >> 15;
+            _tiles[row * _columns + column] = _tileColours.empty() ? 0 : hash % _tileColours.size();
+        }
+    }
+    invalidate();
+}
+
+void TileMap::drawTile(int tile, SDL_Rect destination) {
+    if (_tileTextures[tile] != nullptr) {
+        SDL_RenderCopy(_renderer, _tileTextures[tile]->texture, NULL, &destination);
+        return;
+    }
+    SDL_Color colour = _tileColours[tile];
+    SDL_SetRenderDrawColor(_renderer, colour.r, colour.g, colour.b, colour.a);
+    SDL_RenderFillRect(_renderer, &destination);
+
+    //A slightly darker edge so the ground visibly scrolls with the camera
+    SDL_SetRenderDrawColor(_renderer, max(0, colour.r - 8), max(0, colour.g - 8), max(0, colour.b - 8), colour.a);
+    SDL_RenderDrawRect(_renderer, &destination);
+}
+
+TextureHandle TileMap::buildChunk(int chunkColumn, int chunkRow) {
+    TextureHandle chunk(SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, _chunkSize, _chunkSize));
+    if (!chunk) {
+        cout << "Tile chunk could not be created. Error: " << SDL_GetError() << endl;
+        return chunk;
+    }
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(_renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(_renderer, &r, &g, &b, &a);
+    SDL_SetRenderTarget(_renderer, chunk.get());
+
+    int firstColumn = chunkColumn * _chunkTiles;
+    int firstRow = chunkRow * _chunkTiles;
+    for (int row = firstRow; row < min(_rows, firstRow + _chunkTiles); row++) {
+        for (int column = firstColumn; column < min(_columns, firstColumn + _chunkTiles); column++) {
+            SDL_Rect destination = {(column - firstColumn) * _tileSize, (row - firstRow) * _tileSize, _tileSize, _tileSize};
+            drawTile(_tiles[row * _columns + column], destination);
+        }
+    }
+
+    SDL_SetRenderTarget(_renderer, previousTarget);
+    SDL_SetRenderDrawColor(_renderer, r, g, b, a);
+    return chunk;
+}
+
+void TileMap::checkReloads() {
+    //Chunks hold copies of the tile pixels, so a reloaded tile texture means redrawing them
+    for (size_t tile = 0; tile < _tileTextures.size(); tile++) {
+        if (_tileTextures[tile] != nullptr && _tileTextures[tile]->version != _tileVersions[tile]) {
+            _tileVersions[tile] = _tileTextures[tile]->version;
+            invalidate();
+        }
+    }
+}
+
+void TileMap::draw(Camera& camera) {
+    if (_tiles.empty()) {
+        return;
+    }
+    checkReloads();
+
+    SDL_Rect view = camera.getView();
+    int firstColumn = max(0, view.x / _chunkSize);
+    int firstRow = max(0, view.y / _chunkSize);
+    int lastColumn = min(_chunkColumns - 1, (view.x + view.w - 1) / _chunkSize);
+    int lastRow = min(_chunkRows - 1, (view.y + view.h - 1) / _chunkSize);
+
+    //Chunks more than two away from the view are dropped, one away are prefetched
+    for (auto it = _chunks.begin(); it != _chunks.end();) {
+        int column = it->first % _chunkColumns;
+        int row = it->first / _chunkColumns;
+        if (column < firstColumn - 2 || column > lastColumn + 2 || row < firstRow - 2 || row > lastRow + 2) {
+            it = _chunks.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    int prefetched = 0;
+    for (int row = max(0, firstRow - 1); row <= min(_chunkRows - 1, lastRow + 1); row++) {
+        for (int column = max(0, firstColumn - 1); column <= min(_chunkColumns - 1, lastColumn + 1); column++) {
+            int key = row * _chunkColumns + column;
+            bool onScreen = column >= firstColumn && column <= lastColumn && row >= firstRow && row <= lastRow;
+            auto chunk = _chunks.find(key);
+
+            if (chunk == _chunks.end()) {
+                if (!onScreen && prefetched >= _prefetchPerFrame) {
+                    continue;
+                }
+                if (!onScreen) {
+                    prefetched++;
+                }
+                chunk = _chunks.emplace(key, buildChunk(column, row)).first;
+            }
+
+            if (onScreen && chunk->second) {
+                SDL_Rect destination = camera.toScreen({column * _chunkSize, row * _chunkSize, _chunkSize, _chunkSize});
+                SDL_RenderCopy(_renderer, chunk->second.get(), NULL, &destination);
+            }
+        }
+    }
+}
+
+void TileMap::invalidate() {
+    //Render target contents are lost when the device resets, so every chunk is rebuilt on demand
+    _chunks.clear();
+}
@@ -0,0 +1,25 @@
+#include <headers/updateScheduler.h>
+
+void UpdateScheduler::beginFrame(SDL_Point focus) {
+    _frame++;
+    _focus = focus;
+}
+
+int UpdateScheduler::getInterval(SDL_Rect position, bool visible) {
+    //Anything on screen is drawn every frame so it has to be ticked every frame too
+    if (visible) {
+        return 1;
+    }
+
+    int dx = position.x + position.w / 2 - _focus.x;
+    int dy = position.y + position.h / 2 - _focus.y;
+    int distanceSquared = dx * dx + dy * dy;
+
+    if (distanceSquared < _nearDistance * _nearDistance) {
+        return 1;
+    }
+    if (distanceSquared < _farDistance * _farDistance) {
+        return _midInterval;
+    }
+    return _farInterval;
+}
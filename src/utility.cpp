@@ -1,21 +1,35 @@
 #include <headers/utility.h>
 
-SDL_Texture* loadTexture(SDL_Renderer* renderer, const char* filepath) {
-    SDL_Texture* tex = NULL;
-    tex = IMG_LoadTexture(renderer, filepath);
+TextureHandle loadTexture(SDL_Renderer* renderer, const char* filepath) {
+    TextureHandle tex(IMG_LoadTexture(renderer, filepath));
 
-    if (tex == NULL) {
+    if (!tex) {
         cout << "Image could not load from file path: " << filepath << " Error: " << SDL_GetError() << std::endl;
     }
     return tex;
 }
 
-TTF_Font* loadFont(const char* filepath, int size) {
-    TTF_Font* font = NULL;
-    font = TTF_OpenFont(filepath, size);
+FontHandle loadFont(const char* filepath, int size) {
+    FontHandle font(TTF_OpenFont(filepath, size));
 
-    if (font == NULL) {
+    if (!font) {
         cout << "Font could not open from file path: " << filepath << " Error: " << SDL_GetError() << std::endl;
     }
     return font;
-}
\ No newline at end of file
+}
+static Uint32 randomState = 2463534242; //Xorshift state, kept here so snapshots can save and restore it
+
+int randomInt(int min, int max) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return min + (randomState % (max - min + 1));
+}
+
+Uint32 getRandomState() {
+    return randomState;
+}
+
+void setRandomState(Uint32 state) {
+    randomState = state;
+}